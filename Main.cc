@@ -21,6 +21,7 @@
  OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  **************************************************************************************************/
 #include <cstddef>
+#include <cinttypes>
 #include <gmpxx.h>
 #include <fstream>
 #include <errno.h>
@@ -40,13 +41,20 @@
 #include "fsm/LSystemParser.h"
 #include "core/Solver.h"
 #include "core/Config.h"
+#include "core/ClauseExchange.h"
+#include "core/Snapshot.h"
+#include "core/BinaryGnf.h"
 #include <unistd.h>
+#include <sys/socket.h>
 #include <sys/time.h>
+#include <sys/un.h>
 #include <algorithm>
 #include <sstream>
 #include <algorithm>
 #include <iterator>
+#include <memory>
 #include <unordered_map>
+#include <thread>
 #include "simp/SimpSolver.h"
 #include "pb/PbTheory.h"
 #include "pb/PbParser.h"
@@ -72,10 +80,13 @@ void printStats(Solver& solver) {
 }
 
 static SimpSolver* solver;
+static vec<SimpSolver*> portfolio;
 // Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
 // for this feature of the Solver as it may take longer than an immediate call to '_exit()'.
 static void SIGINT_interrupt(int signum) {
 	solver->interrupt();
+	for (SimpSolver * s : portfolio)
+		s->interrupt();
 	printf("\n");
 	printf("*** INTERRUPTED ***\n");
 	if (opt_verb > 0) {
@@ -100,6 +111,30 @@ static void SIGINT_exit(int signum) {
 	_exit(1);
 }
 
+//A hash of the (decompressed) contents of the input file, to identify it in snapshots.
+static uint64_t fingerprintInput(const char * filename) {
+	gzFile in = gzopen(filename, "rb");
+	if (in == NULL)
+		return 0;
+	std::vector<unsigned char> buf(1 << 20);
+	uLong crc = crc32(0L, Z_NULL, 0);
+	uint64_t length = 0;
+	int n;
+	while ((n = gzread(in, buf.data(), buf.size())) > 0) {
+		crc = crc32(crc, buf.data(), n);
+		length += n;
+	}
+	gzclose(in);
+	return (length << 32) ^ crc;
+}
+
+//Write a checkpoint at the next restart, then stop (for preemptible jobs, which receive SIGTERM before they are killed).
+//A second SIGTERM ends the process at once.
+static void SIGTERM_checkpoint(int signum) {
+	solver->requestCheckpoint(true);
+	signal(SIGTERM, SIG_DFL);
+}
+
 //Select which algorithms to apply for graph and geometric theory solvers, by parsing command line arguments and defaults.
 void selectAlgorithms(){
 	mincutalg = MinCutAlg::ALG_EDMONSKARP;
@@ -255,6 +290,621 @@ void selectAlgorithms(){
 	}
 }
 
+//Memory map 'filename' for 'GnfInput::parse()', if it is binary gnf, or a regular, uncompressed file (and -parse-threads is not 0).
+static bool mapInput(MappedFile & mapped, const char * filename) {
+	if (!filename || !mapped.open(filename))
+		return false;
+	if (isBinaryGnf(mapped.bytes(), mapped.size()))
+		return true;
+	if (opt_parse_threads <= 0) {
+		mapped.close();
+		return false;
+	}
+	if (mapped.size() >= 2 && (unsigned char) mapped.bytes()[0] == 0x1f && (unsigned char) mapped.bytes()[1] == 0x8b) {
+		mapped.close(); //gzipped
+		return false;
+	}
+	return true;
+}
+
+//The parsers for gnf input. They are kept alive for as long as the solver in server mode (see 'serve()'),
+//so that the fragments added between solves can refer to the graphs and other constraints of the input.
+class GnfInput {
+	Dimacs<StreamBuffer, SimpSolver> parser;
+	BVParser<char *, SimpSolver> bvParser;
+	SymbolParser<char*,SimpSolver> symbolParser;
+	GraphParser<char *, SimpSolver> graphParser;
+	FSMParser<char*,SimpSolver> fsmParser;
+	LSystemParser<char*,SimpSolver>  lparser;
+	AMOParser<char *, SimpSolver> amo;
+	std::unique_ptr<Parser<char*, SimpSolver>> geometryParser;
+public:
+	GnfInput(bool precise) :
+			graphParser(precise, bvParser.theory) {
+		parser.addParser(&bvParser);
+		parser.addParser(&symbolParser);
+		parser.addParser(&graphParser);
+		parser.addParser(&fsmParser);
+		parser.addParser(&lparser);
+		parser.addParser(&amo);
+		if (precise)
+			geometryParser.reset(new GeometryParser<char *, SimpSolver, mpq_class>());
+		else
+			geometryParser.reset(new GeometryParser<char *, SimpSolver, double>());
+		parser.addParser(geometryParser.get());
+	}
+
+	//Parse the gnf file into S; from 'mapped' if it is non-null (see 'mapInput()'),
+	//and otherwise from the (optionally gzipped) file 'in'.
+	void parse(gzFile in, const MappedFile * mapped, SimpSolver & S) {
+		if (mapped && isBinaryGnf(mapped->bytes(), mapped->size()))
+			parser.parse_binary(mapped->bytes(), mapped->size(), S, graphParser);
+		else if (mapped)
+			parser.parse_mapped(mapped->bytes(), mapped->size(), S, opt_parse_threads);
+		else
+			parser.parse_DIMACS(in, S);
+	}
+
+	//Parse more gnf text into S (which must be at decision level 0), after the input has been parsed.
+	void parseFragment(const char * text, size_t size, SimpSolver & S) {
+		parser.parse_mapped(text, size, S, 0);
+	}
+
+	//Scopes for the constraints that are parsed between solves (see 'Dimacs::push()').
+	void push(Lit activation) {
+		parser.push(activation);
+	}
+	Lit pop() {
+		return parser.pop();
+	}
+	const vec<Lit> & openScopes() const {
+		return parser.openScopes();
+	}
+	int headerVars() const {
+		return parser.headerVars();
+	}
+
+	std::vector<std::pair<int, std::string> > & symbols() {
+		return symbolParser.getSymbols();
+	}
+};
+
+static void readPriorities(SimpSolver & S, const char * priority_file) {
+	if (strlen(priority_file) > 0) {
+		FILE * f = fopen(priority_file, "r");
+		if (f) {
+			char * line = NULL;
+			int v = 0;
+			int p = 0;
+			int total_read = 0;
+			while (fscanf(f, " %d %d ", &v, &p) == 2) {
+				if (v < 1 || v > S.nVars() ) {
+					fprintf(stderr, "Bad priority line: %d %d", v, p);
+					exit(1);
+				}
+				v--;
+				total_read++;
+				S.setDecisionPriority(v, p);
+			}
+			if (total_read == 0) {
+				fprintf(stderr, "Warning: read no priorities from priority file!");
+			}
+			fclose(f);
+		} else {
+			fprintf(stderr, "Failed to read priority file!\n");
+		}
+	}
+}
+
+static void setDecidableTheories(SimpSolver & S, const vec<int> & decidable) {
+	if (opt_verb > 0 && decidable.size()) {
+		printf("Decidable theories: ");
+	}
+	S.decidable_theories.clear();
+	for (int i = 0; i < decidable.size(); i++) {
+		int t = decidable[i];
+		if (t < 0 || t >= S.theories.size()) {
+			fprintf(stderr, "Cannot set theory %d to be decidable, because there is no such theory\n", t);
+			fflush(stderr);
+			exit(1);
+		}
+		if (opt_verb > 0) {
+			printf("%d, ", t);
+		}
+		S.decidable_theories.push(S.theories[t]);
+	}
+	if (opt_verb > 0 && decidable.size()) {
+		printf("\n");
+	}
+
+	if(opt_decide_theories_reverse){
+		vec<Theory*> v;
+		for (int i = S.decidable_theories.size()-1;i>=0;i--){
+			v.push(S.decidable_theories[i]);
+		}
+		S.decidable_theories.clear();
+		for (Theory * t:v)
+			S.decidable_theories.push(t);
+	}
+}
+
+//Graph algorithms that the copies of a portfolio cycle through (the 'cnf' encodings are never selected,
+//as they change the variables of the instance, which would prevent clause sharing)
+static const char * portfolio_reach_algs[] = { "ramal-reps", "bfs", "dfs", "dijkstra" };
+static const char * portfolio_maxflow_algs[] = { "kohli-torr", "edmondskarp-adj", "dinitz", "edmondskarp-dynamic" };
+static const char * portfolio_dist_algs[] = { "ramal-reps", "dijkstra", "bfs" };
+
+//Select the graph algorithms used by copy 'copy' of the portfolio. Copy 0 uses the ones given on the command line.
+static void selectPortfolioAlgorithms(int copy, const char * reach_alg, const char * maxflow_alg, const char * dist_alg) {
+	if (copy == 0) {
+		opt_reach_alg = reach_alg;
+		opt_maxflow_alg = maxflow_alg;
+		opt_dist_alg = dist_alg;
+	} else {
+		if (strcasecmp(reach_alg, "cnf"))
+			opt_reach_alg = portfolio_reach_algs[copy % 4];
+		if (strcasecmp(maxflow_alg, "cnf"))
+			opt_maxflow_alg = portfolio_maxflow_algs[(copy / 2) % 4];
+		if (strcasecmp(dist_alg, "cnf"))
+			opt_dist_alg = portfolio_dist_algs[copy % 3];
+	}
+	selectAlgorithms();
+}
+
+//Give each copy of the portfolio its own seed, restart policy, phase saving and theory decision policy.
+//Copy 0 keeps the settings given on the command line.
+static void diversify(SimpSolver & S, int copy, bool decide_theories) {
+	S.decide_theories = decide_theories;
+	if (copy == 0)
+		return;
+	static const int restart_firsts[] = { 100, 50, 300, 1000 };
+	S.random_seed = opt_random_seed + 7919 * copy;
+	S.luby_restart = (copy % 2 == 0) ? opt_luby_restart : !opt_luby_restart;
+	S.restart_inc = S.luby_restart ? 2 : 1.5;
+	S.restart_first = restart_firsts[copy % 4];
+	S.phase_saving = (copy % 3 == 2) ? 1 : (int) opt_phase_saving;
+	S.rnd_init_act = copy >= 4;
+	if (copy % 2 == 1)
+		S.decide_theories = !decide_theories;
+}
+
+//Build an additional copy of the primary solver S, by parsing the input file again.
+static SimpSolver * buildPortfolioCopy(SimpSolver & S, int copy, const char * filename, bool precise,
+		const vec<int> & decidable, bool decide_theories) {
+	SimpSolver * C = new SimpSolver();
+	C->min_decision_var = S.min_decision_var;
+	C->max_decision_var = S.max_decision_var;
+	C->min_priority_var = S.min_priority_var;
+	C->max_priority_var = S.max_priority_var;
+	diversify(*C, copy, decide_theories);
+	if (!opt_pre)
+		C->eliminate(true);
+
+	MappedFile mapped;
+	bool is_mapped = mapInput(mapped, filename);
+	gzFile in = is_mapped ? NULL : gzopen(filename, "rb");
+	if (!is_mapped && in == NULL)
+		printf("ERROR! Could not open file: %s\n", filename), exit(1);
+	GnfInput input(precise);
+	input.parse(in, is_mapped ? &mapped : nullptr, *C);
+	if (in)
+		gzclose(in);
+	mapped.close();
+
+	readPriorities(*C, opt_priority);
+	setDecidableTheories(*C, decidable);
+	C->preprocess();
+	if (opt_pre)
+		C->eliminate(true);
+	return C;
+}
+
+//Variables can only be shared if they have the same meaning in every copy of the portfolio: they must exist
+//in every copy, must not have been eliminated, and must map to the same theory variable.
+static void findShareableVars(vec<SimpSolver*> & solvers, vec<bool> & shareable) {
+	int n = solvers[0]->nVars();
+	for (SimpSolver * s : solvers)
+		n = std::min(n, s->nVars());
+	shareable.clear();
+	shareable.growTo(n, true);
+	SimpSolver & S = *solvers[0];
+	for (Var v = 0; v < n; v++) {
+		for (SimpSolver * s : solvers) {
+			if (s->isEliminated(v) || s->hasTheory(v) != S.hasTheory(v)
+					|| (S.hasTheory(v)
+							&& (s->getTheoryID(v) != S.getTheoryID(v) || s->getTheoryVar(v) != S.getTheoryVar(v)))) {
+				shareable[v] = false;
+				break;
+			}
+		}
+	}
+}
+
+static void solvePortfolioCopy(vec<SimpSolver*> * solvers, int copy, ClauseExchange * exchange,
+		const vec<Lit> * assume, lbool * result) {
+	SimpSolver & S = *(*solvers)[copy];
+	*result = S.solveLimited(*assume);
+	if (*result != l_Undef && exchange->claimWin(copy)) {
+		//the first copy to finish wins; stop all the others
+		for (int i = 0; i < solvers->size(); i++) {
+			if (i != copy)
+				(*solvers)[i]->interrupt();
+		}
+	}
+}
+
+//Run each solver in its own thread, sharing short learnt clauses between them, until the first one finishes.
+//Returns the index of the copy that finished first (or -1 if all were interrupted).
+static int solvePortfolio(vec<SimpSolver*> & solvers, const vec<Lit> & assume, lbool & ret) {
+	vec<bool> shareable;
+	findShareableVars(solvers, shareable);
+	ClauseExchange exchange(solvers.size());
+	for (int i = 0; i < solvers.size(); i++)
+		solvers[i]->setClauseExchange(&exchange, i, shareable);
+
+	vec<lbool> results;
+	results.growTo(solvers.size(), l_Undef);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < solvers.size(); i++)
+		threads.push_back(std::thread(solvePortfolioCopy, &solvers, i, &exchange, &assume, &results[i]));
+	for (std::thread & t : threads)
+		t.join();
+
+	int winner = exchange.getWinner();
+	ret = winner >= 0 ? results[winner] : l_Undef;
+	for (SimpSolver * s : solvers)
+		s->setClauseExchange(nullptr, -1, shareable);
+	return winner;
+}
+
+static void conquerCubes(vec<SimpSolver*> * solvers, int worker, ClauseExchange * exchange, const vec<vec<Lit>> * cubes,
+		const vec<Lit> * assume, std::atomic<int> * next_cube, lbool * result) {
+	SimpSolver & S = *(*solvers)[worker];
+	vec<Lit> assumptions;
+	*result = l_False;
+	int i;
+	while ((i = next_cube->fetch_add(1)) < cubes->size()) {
+		assume->copyTo(assumptions);
+		for (Lit l : (*cubes)[i])
+			assumptions.push(l);
+		lbool r = S.solveLimited(assumptions);
+		if (r == l_False && S.okay())
+			continue; //only this cube is unsatisfiable
+		*result = r;
+		if (r != l_Undef && exchange->claimWin(worker)) {
+			//a satisfying assignment, or a proof that every cube is unsatisfiable; stop the other workers
+			for (int j = 0; j < solvers->size(); j++) {
+				if (j != worker)
+					(*solvers)[j]->interrupt();
+			}
+		}
+		return;
+	}
+}
+
+//Solve the cubes (each in conjunction with 'assume') with a pool of worker threads, one per solver, sharing learnt clauses,
+//until one cube is satisfiable or all of them are unsatisfiable.
+//Returns the index of the worker that found the result (or -1 if there is none, such as if all cubes were unsatisfiable).
+static int conquer(vec<SimpSolver*> & solvers, const vec<vec<Lit>> & cubes, const vec<Lit> & assume, lbool & ret) {
+	vec<bool> shareable;
+	findShareableVars(solvers, shareable);
+	ClauseExchange exchange(solvers.size());
+	if (solvers.size() > 1) {
+		for (int i = 0; i < solvers.size(); i++)
+			solvers[i]->setClauseExchange(&exchange, i, shareable);
+	}
+	std::atomic<int> next_cube(0);
+	vec<lbool> results;
+	results.growTo(solvers.size(), l_Undef);
+	std::vector<std::thread> threads;
+	for (int i = 0; i < solvers.size(); i++)
+		threads.push_back(std::thread(conquerCubes, &solvers, i, &exchange, &cubes, &assume, &next_cube, &results[i]));
+	for (std::thread & t : threads)
+		t.join();
+
+	int winner = exchange.getWinner();
+	if (winner >= 0) {
+		ret = results[winner];
+	} else {
+		ret = l_False;
+		for (lbool r : results) {
+			if (r != l_False)
+				ret = l_Undef;
+		}
+	}
+	if (solvers.size() > 1) {
+		for (SimpSolver * s : solvers)
+			s->setClauseExchange(nullptr, -1, shareable);
+	}
+	return winner;
+}
+
+//Write all of 's' to the socket 'fd'. Returns false if the client has gone away.
+static bool sendAll(int fd, const std::string & s) {
+	size_t sent = 0;
+	while (sent < s.size()) {
+		ssize_t n = write(fd, s.data() + sent, s.size() - sent);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return false;
+		sent += n;
+	}
+	return true;
+}
+
+//Match the command 'name' (a whole word) at the start of the 0-terminated line 'p', advancing 'p' past it.
+static bool matchCommand(const char *& p, const char * name) {
+	size_t n = strlen(name);
+	if (strncmp(p, name, n) != 0 || !(p[n] == 0 || isWhitespace(p[n])))
+		return false;
+	p += n;
+	return true;
+}
+
+//Read the DIMACS integers of a command (up to an optional terminating 0) into 'vals'. Returns false if there is anything else.
+static bool readCommandInts(const char * p, std::vector<int> & vals) {
+	vals.clear();
+	for (;;) {
+		while (isWhitespace(*p))
+			p++;
+		if (*p == 0)
+			return true;
+		char * end;
+		long v = strtol(p, &end, 10);
+		if (end == p || v < INT32_MIN + 1 || v > INT32_MAX)
+			return false;
+		p = end;
+		if (v == 0)
+			return true;
+		vals.push_back(v);
+	}
+}
+
+/**
+ * A session of gnf lines and commands, for the server (-server) and command stream (-stream) modes, which applies them to
+ * the solver S (so that S keeps its learnt clauses between solves). Gnf lines (clauses, edges, reach atoms and other
+ * constraints) are added to the solver just before the next command. The commands are:
+ *   solve [<lit> ...] [0]   solve under these assumptions (and the activation literals of the open scopes);
+ *                           replies 's SATISFIABLE' or 's UNSATISFIABLE'
+ *   model [<var> ...] [0]   replies the values of these (or all) variables in the last satisfying assignment, as 'v <lit> ... 0'
+ *                           (leaving out those that it does not assign, which can take either value)
+ *   push                    open a scope, with a fresh variable as its activation literal; replies 'a <var>'
+ *   pop                     close the innermost scope, retracting the clauses that were added in it
+ *   quit                    end the session
+ *   shutdown                end the session, and stop the server
+ * Malformed commands receive the reply 'e <message>'; so does the command after gnf lines that do not parse (such as an
+ * edge added to a graph that has already been solved), in which case the lines after the malformed one are dropped
+ * (those before it are added), and the command is not carried out.
+ * As the theory solvers create variables of their own, a session that adds theory constraints should start with a
+ * 'p cnf <vars> <clauses>' header that covers all of the variables it uses.
+ */
+class GnfSession {
+	SimpSolver & S;
+	GnfInput & input;
+	std::string fragment; //the gnf lines since the last command
+	std::vector<int> vals;
+	vec<Lit> assume;
+	bool has_model = false;
+
+	//Add the pending gnf lines to the solver. Returns an error reply if one of them does not parse (in which case the
+	//lines before it have been added, and those after it are dropped).
+	//(only then is the trail backtracked to level 0, so that, with -reuse-trail, consecutive solves can keep it)
+	std::string flushFragment() {
+		if (fragment.empty())
+			return "";
+		S.cancelUntil(0);
+		std::string error;
+		try {
+			input.parseFragment(fragment.data(), fragment.size(), S);
+		} catch (ParseError & e) {
+			error = "e " + e.message + "\n";
+			std::replace(error.begin(), error.end() - 1, '\n', ' ');
+		}
+		fragment.clear();
+		//(the new lines may have added theories, or atoms to them, which must be preprocessed before the next solve; the
+		//solves themselves leave the theories alone)
+		S.preprocess();
+		return error;
+	}
+
+	std::string solve(const char * args) {
+		assume.clear();
+		if (!readCommandInts(args, vals))
+			return "e bad assumption\n";
+		for (int l : vals) {
+			if (abs(l) > S.nVars())
+				return "e unknown variable " + std::to_string(abs(l)) + "\n";
+			assume.push(mkLit(abs(l) - 1, l < 0));
+		}
+		for (Lit a : input.openScopes())
+			assume.push(a);
+		double start = rtime(0);
+		has_model = S.solve(assume);
+		if (opt_verb > 1)
+			printf("Solved %d assumptions in %f s\n", assume.size(), rtime(0) - start);
+		return has_model ? "s SATISFIABLE\n" : "s UNSATISFIABLE\n";
+	}
+
+	std::string model(const char * args) {
+		if (!has_model)
+			return "e no satisfying assignment\n";
+		if (!readCommandInts(args, vals))
+			return "e bad variable\n";
+		if (vals.empty()) {
+			for (int v = 1; v <= S.model.size(); v++)
+				vals.push_back(v);
+		}
+		std::string reply = "v";
+		for (int v : vals) {
+			if (v < 1 || v > S.model.size())
+				return "e unknown variable " + std::to_string(v) + "\n";
+			if (S.model[v - 1] == l_Undef)
+				continue;
+			reply += ' ';
+			reply += std::to_string(S.model[v - 1] == l_False ? -v : v);
+		}
+		return reply + " 0\n";
+	}
+
+	//(the activation variable is created here, as a variable chosen by the client may already be in use, by the
+	//client or by a theory solver, which would make the scope constrain it)
+	std::string push(const char * args) {
+		if (!readCommandInts(args, vals) || vals.size())
+			return "e push takes no arguments\n";
+		Var v = S.newVar();
+		input.push(mkLit(v));
+		return "a " + std::to_string(v + 1) + "\n";
+	}
+
+	std::string pop() {
+		if (input.openScopes().size() == 0)
+			return "e no open scope\n";
+		//(the clauses of the scope, and the clauses learnt from them, are now satisfied, and will be removed by 'simplify()')
+		S.addClause(~input.pop());
+		return "";
+	}
+
+public:
+	bool running = true; //false after 'shutdown'
+
+	GnfSession(SimpSolver & S, GnfInput & input) :
+			S(S), input(input) {
+		//(the variables of the input's header may be used by later lines, so they must not be taken by 'push')
+		while (S.nVars() < input.headerVars())
+			S.newVar();
+	}
+
+	//Handle the line [line, eol] (where 'eol' is its newline), setting 'reply' to its reply, if it has one.
+	//Returns false if the line ends the session.
+	bool handle(char * line, char * eol, std::string & reply) {
+		reply.clear();
+		const char * p = line;
+		while (p < eol && isWhitespace(*p))
+			p++;
+		*eol = 0;
+		bool command = true;
+		if (matchCommand(p, "solve")) {
+			reply = flushFragment();
+			if (reply.empty())
+				reply = solve(p);
+		} else if (matchCommand(p, "model")) {
+			reply = model(p);
+		} else if (matchCommand(p, "push")) {
+			reply = flushFragment();
+			if (reply.empty())
+				reply = push(p);
+		} else if (matchCommand(p, "pop")) {
+			reply = flushFragment();
+			if (reply.empty())
+				reply = pop();
+		} else if (matchCommand(p, "quit")) {
+			return false;
+		} else if (matchCommand(p, "shutdown")) {
+			running = false;
+			return false;
+		} else {
+			command = false;
+			if (strncmp(p, "p cnf", 5) == 0) {
+				//the theory solvers create variables of their own as the constraints are added, so the variables
+				//of the header are created up front, to keep them from being taken
+				long n = strtol(p + 5, nullptr, 10);
+				S.cancelUntil(0);
+				while (S.nVars() < n)
+					S.newVar();
+			}
+		}
+		*eol = '\n';
+		if (!command)
+			fragment.append(line, eol + 1);
+		return true;
+	}
+
+	//End the session: discard the gnf lines since the last command, close the scopes that it left open, and forget its
+	//model, so that the next session (of the server) only sees the constraints that were added for good.
+	void reset() {
+		fragment.clear();
+		S.cancelUntil(0);
+		while (input.openScopes().size())
+			S.addClause(~input.pop());
+		has_model = false;
+	}
+};
+
+//Run a session on the lines read from 'in', writing the replies to 'out', until it ends (or 'in' is closed).
+static void runSession(int in, int out, GnfSession & session) {
+	std::string buffer;
+	std::string reply;
+	char chunk[1 << 16];
+	size_t pos = 0;
+	for (;;) {
+		size_t eol = buffer.find('\n', pos);
+		if (eol == std::string::npos) {
+			buffer.erase(0, pos);
+			pos = 0;
+			ssize_t n = read(in, chunk, sizeof(chunk));
+			if (n < 0 && errno == EINTR)
+				continue;
+			if (n <= 0)
+				break;
+			buffer.append(chunk, n);
+			continue;
+		}
+		bool more = session.handle(&buffer[pos], &buffer[eol], reply);
+		pos = eol + 1;
+		if (reply.size()) {
+			fflush(stdout);
+			if (!sendAll(out, reply))
+				break;
+		}
+		if (!more)
+			break;
+	}
+	session.reset();
+}
+
+/**
+ * Server mode (-server): run a session (see 'GnfSession') for each client of the Unix domain socket 'path', one
+ * connection at a time, on the solver S, which has already been loaded with the input.
+ */
+static int serve(const char * path, SimpSolver & S, GnfInput & input) {
+	sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (strlen(path) >= sizeof(addr.sun_path))
+		fprintf(stderr, "ERROR! Socket path is too long: %s\n", path), exit(1);
+	strcpy(addr.sun_path, path);
+	int server = socket(AF_UNIX, SOCK_STREAM, 0);
+	unlink(path);
+	if (server < 0 || bind(server, (sockaddr*) &addr, sizeof(addr)) != 0 || listen(server, 16) != 0)
+		fprintf(stderr, "ERROR! Could not listen on %s: %s\n", path, strerror(errno)), exit(1);
+#if not defined(__MINGW32__)
+	signal(SIGPIPE, SIG_IGN);
+	signal(SIGINT, SIGINT_exit);
+#endif
+	if (opt_verb > 0) {
+		printf("Listening on %s\n", path);
+		fflush(stdout);
+	}
+
+	GnfSession session(S, input);
+	while (session.running) {
+		int client = accept(server, nullptr, nullptr);
+		if (client < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+		runSession(client, client, session);
+		close(client);
+	}
+	close(server);
+	unlink(path);
+	if (opt_verb > 0)
+		printStats(S);
+	return 0;
+}
+
 int main(int argc, char** argv) {
 	try {
 		setUsageHelp(
@@ -287,21 +937,104 @@ int main(int argc, char** argv) {
 		StringOption opt_witness_file("MAIN", "witness-file", "write witness to file", "");
 		StringOption opt_theory_witness_file("MAIN", "theory-witness-file", "write witness for theories to file", "");
 
+		IntOption opt_portfolio("MAIN", "portfolio",
+				"Number of differently configured copies of the solver to run in parallel threads (sharing learnt clauses), stopping when the first one finishes. 1 disables portfolio mode.\n",
+				1, IntRange(1, 1024));
+		StringOption opt_cube("MAIN", "cube",
+				"Split the problem into cubes of assumptions (by lookahead on theory atoms), write them to this file ('a <lit> ... <lit> 0' per line), then quit",
+				"");
+		IntOption opt_cube_depth("MAIN", "cube-depth", "Split on at most this many variables per cube (for at most 2^depth cubes)",
+				6, IntRange(0, 30));
+		IntOption opt_cube_candidates("MAIN", "cube-candidates",
+				"Number of theory atoms (those that occur in the most clauses) to consider for each split", 64,
+				IntRange(1, INT32_MAX));
+		StringOption opt_conquer("MAIN", "conquer",
+				"Solve the cubes in this file (as written by -cube) as assumptions, stopping at the first satisfiable one", "");
+		IntOption opt_conquer_workers("MAIN", "conquer-workers",
+				"Number of differently configured copies of the solver that solve cubes in parallel threads (sharing learnt clauses)\n",
+				1, IntRange(1, 1024));
+
+		StringOption opt_checkpoint("MAIN", "checkpoint",
+				"Periodically (and on SIGTERM) write a snapshot of the search state to this file, to resume from with -restore (theory state is not saved)",
+				"");
+		DoubleOption opt_checkpoint_interval("MAIN", "checkpoint-interval",
+				"Seconds between snapshots (0 to only write them on SIGTERM)", 600, DoubleRange(0, true, HUGE_VAL, true));
+		StringOption opt_server("MAIN", "server",
+				"Load the input, then serve incremental constraints and solve requests on this Unix domain socket (see README)", "");
+		BoolOption opt_stream("MAIN", "stream",
+				"Read the input as a stream of gnf lines and commands (solve, model, push, pop), answering each command on stdout (see README)",
+				false);
+		StringOption opt_gnf2bin("MAIN", "gnf2bin",
+				"Convert the input to binary gnf (read automatically; only clauses, integer graphs, edges and reach atoms load faster, other lines stay text), write it to this file, then quit",
+				"");
+		StringOption opt_restore("MAIN", "restore",
+				"Resume from a snapshot written by -checkpoint (this requires the original input file, which is parsed again to rebuild the theories, and the same options)",
+				"");
+
 		BoolOption opb("PB", "opb", "Parse the input as pseudo-boolean constraints in .opb format", false);
 		BoolOption precise("GEOM", "precise",
 				"Solve geometry using precise rational arithmetic (instead of unsound, but faster, floating point arithmetic)",
 				true);
 
 		parseOptions(argc, argv, true);
+		if (strlen(opt_gnf2bin) > 0) {
+			MappedFile mapped;
+			if (argc > 1 && mapInput(mapped, argv[1]) && isBinaryGnf(mapped.bytes(), mapped.size()))
+				printf("ERROR! %s is already binary gnf\n", argv[1]), exit(1);
+			mapped.close();
+			gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
+			if (in == NULL)
+				printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
+			BinaryGnfWriter writer;
+			writer.convert(in);
+			gzclose(in);
+			if (!writer.write(opt_gnf2bin))
+				fprintf(stderr, "Could not write binary gnf file %s\n", (const char*) opt_gnf2bin), exit(1);
+			if (opt_verb > 0) {
+				printf("Wrote %s: %" PRIu64 " clauses, %" PRIu64 " graphs, %" PRIu64 " edges, %" PRIu64
+						" reachability atoms and %" PRIu64 " other lines\n", (const char*) opt_gnf2bin,
+						writer.records(BinaryGnfSection::Clauses), writer.records(BinaryGnfSection::Graphs),
+						writer.records(BinaryGnfSection::Edges), writer.records(BinaryGnfSection::Reaches),
+						writer.records(BinaryGnfSection::Lines));
+			}
+			exit(0);
+		}
 		if (opt_adaptive_conflict_mincut == 1) {
 			opt_conflict_min_cut = true;
 			opt_conflict_min_cut_maxflow = true;
 		}
 		bool using_symbols_asp = strlen((const char*) opt_symbols_asp) > 0;
+		bool conquering = strlen(opt_conquer) > 0;
+		if (conquering) {
+			//the cube workers are built in the same way as the copies of a portfolio
+			if (opt_portfolio > 1)
+				fprintf(stderr, "WARNING: -portfolio is ignored when solving cubes; use -conquer-workers\n");
+			opt_portfolio = opt_conquer_workers;
+		}
+
+		if (opt_portfolio > 1 && argc == 1) {
+			fprintf(stderr, "WARNING: portfolio mode must re-read its input file, and so cannot read from stdin; using a single solver\n");
+			opt_portfolio = 1;
+		}
+		if (opt_portfolio > 1 && strlen(opt_proof) > 0) {
+			fprintf(stderr, "WARNING: proofs cannot be written in portfolio mode (the solvers share learnt clauses); using a single solver\n");
+			opt_portfolio = 1;
+		}
+		//In portfolio mode, only some of the copies make theory decisions, so the theories must be prepared to make them.
+		bool decide_theories = opt_decide_theories;
+		if (opt_portfolio > 1)
+			opt_decide_theories = true;
 
 		if (opt_csv) {
 			opt_verb = 0;
 		}
+		//In stream mode, standard output carries the replies, so everything else that is printed goes to standard error.
+		int stream_out = 1;
+		if (opt_stream) {
+			fflush(stdout);
+			stream_out = dup(1);
+			dup2(2, 1);
+		}
 #if defined(__linux__)
 		fpu_control_t oldcw, newcw;
 		_FPU_GETCW(oldcw);
@@ -354,17 +1087,33 @@ int main(int argc, char** argv) {
 		S.max_decision_var = opt_max_decision_var - 1;
 		S.min_priority_var = opt_min_priority_decision_var - 1;
 		S.max_priority_var = opt_max_priority_decision_var - 1;
+		diversify(S, 0, decide_theories);
+		if (strlen(opt_proof) > 0) {
+			std::string formula_file =
+					strlen(opt_proof_formula) > 0 ? (const char*) opt_proof_formula : std::string(opt_proof) + ".cnf";
+			if (!S.openProof(opt_proof, formula_file.c_str(), opt_proof_binary))
+				printf("ERROR! Could not open proof file: %s\n", (const char*) opt_proof), exit(1);
+		}
 
 		if (opt_min_decision_var > 1 || opt_max_decision_var > 0) {
 			printf(
 					"Decision variables restricted to the range (%d..%d), which means a result of satisfiable may not be trustworthy.\n",
 					(uint) opt_min_decision_var, (uint) opt_max_decision_var);
 		}
-		if (!opt_pre)
+		//(in server and stream mode, later constraints may refer to any variable, so none can be eliminated)
+		bool serving = strlen(opt_server) > 0;
+		bool streaming = opt_stream;
+		if (!opt_pre || serving || streaming)
 			S.eliminate(true);
 
-		gzFile in = (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
-		if (in == NULL)
+		//(in stream mode, the input is read line by line, after the solver has been set up)
+		int stream_in = !streaming ? -1 : (argc == 1) ? 0 : open(argv[1], O_RDONLY);
+		if (streaming && stream_in < 0)
+			printf("ERROR! Could not open file: %s\n", argv[1]), exit(1);
+		MappedFile mapped;
+		bool is_mapped = !streaming && argc > 1 && mapInput(mapped, argv[1]);
+		gzFile in = (is_mapped || streaming) ? NULL : (argc == 1) ? gzdopen(0, "rb") : gzopen(argv[1], "rb");
+		if (!is_mapped && !streaming && in == NULL)
 			printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
 
 		if (opt_verb > 0) {
@@ -372,41 +1121,16 @@ int main(int argc, char** argv) {
 			printf("|                                                                             |\n");
 		}
 
-		Dimacs<StreamBuffer, SimpSolver> parser;
-		BVParser<char *, SimpSolver> bvParser;
-		parser.addParser(&bvParser);
-
-		SymbolParser<char*,SimpSolver> symbolParser;
-		parser.addParser(&symbolParser);
-
-		GraphParser<char *, SimpSolver> graphParser(precise,bvParser.theory);
-		parser.addParser(&graphParser);
+		GnfInput input(precise);
+		if (!streaming)
+			input.parse(in, is_mapped ? &mapped : nullptr, S);
+		std::vector<std::pair<int, std::string> > & symbols = input.symbols();
 
+		if (in)
+			gzclose(in);
+		mapped.close();
 
 
-		FSMParser<char*,SimpSolver> fsmParser;
-		parser.addParser(&fsmParser);
-		LSystemParser<char*,SimpSolver>  lparser;
-		parser.addParser(&lparser);
-
-		AMOParser<char *, SimpSolver> amo;
-		parser.addParser(&amo);
-
-
-		if (precise) {
-			GeometryParser<char *, SimpSolver, mpq_class>  geometryParser;
-			parser.addParser(&geometryParser);
-			parser.parse_DIMACS(in, S);//this call must happen here, otherwise the geometryParser will be de-allocated!
-		} else {
-			GeometryParser<char *, SimpSolver, double> geometryParser;
-			parser.addParser(&geometryParser);
-			parser.parse_DIMACS(in, S);//this call must happen here, otherwise the geometryParser will be de-allocated!
-		}
-
-		gzclose(in);
-
-		vec<std::pair<int, std::string> > & symbols = symbolParser.getSymbols();
-
 		if (opt_verb > 2) {
 			for (int i = 0; i < symbols.size(); i++) {
 				int v = symbols[i].first;
@@ -422,31 +1146,7 @@ int main(int argc, char** argv) {
 		signal(SIGXCPU, SIGINT_interrupt);
 #endif
 
-		const char * priority_file = opt_priority;
-		if (strlen(priority_file) > 0) {
-			FILE * f = fopen(priority_file, "r");
-			if (f) {
-				char * line = NULL;
-				int v = 0;
-				int p = 0;
-				int total_read = 0;
-				while (fscanf(f, " %d %d ", &v, &p) == 2) {
-					if (v < 1 || v > S.nVars() ) {
-						fprintf(stderr, "Bad priority line: %d %d", v, p);
-						exit(1);
-					}
-					v--;
-					total_read++;
-					S.setDecisionPriority(v, p);
-				}
-				if (total_read == 0) {
-					fprintf(stderr, "Warning: read no priorities from priority file!");
-				}
-				fclose(f);
-			} else {
-				fprintf(stderr, "Failed to read priority file!\n");
-			}
-		}
+		readPriorities(S, opt_priority);
 
 		vec<int> decidable;
 
@@ -544,35 +1244,7 @@ int main(int argc, char** argv) {
 			printf("\n");
 		}
 
-		if (opt_verb > 0 && decidable.size()) {
-			printf("Decidable theories: ");
-		}
-		S.decidable_theories.clear();
-		for (int i = 0; i < decidable.size(); i++) {
-			int t = decidable[i];
-			if (t < 0 || t >= S.theories.size()) {
-				fprintf(stderr, "Cannot set theory %d to be decidable, because there is no such theory\n", t);
-				fflush(stderr);
-				exit(1);
-			}
-			if (opt_verb > 0) {
-				printf("%d, ", t);
-			}
-			S.decidable_theories.push(S.theories[t]);
-		}
-		if (opt_verb > 0 && decidable.size()) {
-			printf("\n");
-		}
-
-		if(opt_decide_theories_reverse){
-			vec<Theory*> v;
-			for (int i = S.decidable_theories.size()-1;i>=0;i--){
-				v.push(S.decidable_theories[i]);
-			}
-			S.decidable_theories.clear();
-			for (Theory * t:v)
-				S.decidable_theories.push(t);
-		}
+		setDecidableTheories(S, decidable);
 
 		if (strlen((const char*) opt_assume_symbols) > 0) {
 
@@ -641,6 +1313,108 @@ int main(int argc, char** argv) {
 			}
 			S.eliminate(true);
 		}
+
+		if (argc > 1 && (strlen(opt_restore) > 0 || strlen(opt_checkpoint) > 0))
+			S.setInputFingerprint(fingerprintInput(argv[1]));
+		if (strlen(opt_restore) > 0) {
+			double before_restore = rtime(0);
+			if (!S.loadSnapshot(opt_restore)) {
+				fprintf(stderr, "ERROR! Could not restore from %s (the snapshot must be written from the same input, with the same options)\n",
+						(const char*) opt_restore);
+				exit(1);
+			}
+			if (opt_verb > 0) {
+				printf("Restored from %s in %f s (%d learnt clauses)\n", (const char*) opt_restore, rtime(0) - before_restore,
+						S.nLearnts());
+			}
+		}
+		if (strlen(opt_checkpoint) > 0) {
+			S.setCheckpoint(opt_checkpoint, opt_checkpoint_interval);
+#if not defined(__MINGW32__)
+			signal(SIGTERM, SIGTERM_checkpoint);
+#endif
+		}
+
+		if (serving)
+			return serve(opt_server, S, input);
+		if (streaming) {
+#if not defined(__MINGW32__)
+			signal(SIGINT, SIGINT_exit);
+#endif
+			GnfSession session(S, input);
+			runSession(stream_in, stream_out, session);
+			if (opt_verb > 0)
+				printStats(S);
+			return 0;
+		}
+
+		if (strlen(opt_cube) > 0) {
+			vec<vec<Lit>> cubes;
+			S.cube(assume, opt_cube_depth, opt_cube_candidates, cubes);
+			FILE * f = fopen(opt_cube, "w");
+			if (!f)
+				printf("ERROR! Could not open cube file: %s\n", (const char*) opt_cube), exit(1);
+			for (vec<Lit> & c : cubes) {
+				fprintf(f, "a ");
+				for (Lit l : c)
+					fprintf(f, "%d ", dimacs(l));
+				fprintf(f, "0\n");
+			}
+			fclose(f);
+			if (opt_verb > 0) {
+				printf("Wrote %d cubes to %s (cubing time = %f)\n", cubes.size(), (const char*) opt_cube,
+						rtime(0) - before_pre_processing);
+			}
+			if (opt_verb > 1)
+				printStats(S);
+			if (cubes.size() == 0) {
+				//every cube was refuted
+				printf("s UNSATISFIABLE\n");
+				fflush(stdout);
+				return 20;
+			}
+			fflush(stdout);
+			return 0;
+		}
+		vec<vec<Lit>> cubes;
+		if (conquering) {
+			gzFile cube_in = gzopen(opt_conquer, "rb");
+			if (cube_in == NULL)
+				printf("ERROR! Could not open cube file: %s\n", (const char*) opt_conquer), exit(1);
+			parse_Cubes(cube_in, cubes, S);
+			gzclose(cube_in);
+			for (vec<Lit> & c : cubes) {
+				for (Lit l : c) {
+					if (S.isEliminated(var(l))) {
+						fprintf(stderr, "Bad cube literal %d: variable %d was eliminated by preprocessing (rerun with -no-elim)\n",
+								dimacs(l), var(l) + 1);
+						exit(1);
+					}
+				}
+			}
+			if (opt_verb > 0) {
+				printf("Read %d cubes from %s\n", cubes.size(), (const char*) opt_conquer);
+			}
+		}
+
+		if (opt_portfolio > 1) {
+			//Each copy of the portfolio gets its own solver, built by parsing the input again.
+			const char * reach_alg = opt_reach_alg;
+			const char * maxflow_alg = opt_maxflow_alg;
+			const char * dist_alg = opt_dist_alg;
+			int verb = opt_verb;
+			opt_verb = 0;
+			portfolio.push(&S);
+			for (int i = 1; i < opt_portfolio; i++) {
+				selectPortfolioAlgorithms(i, reach_alg, maxflow_alg, dist_alg);
+				portfolio.push(buildPortfolioCopy(S, i, argv[1], precise, decidable, decide_theories));
+			}
+			selectPortfolioAlgorithms(0, reach_alg, maxflow_alg, dist_alg);
+			opt_verb = verb;
+			if (opt_verb > 0) {
+				printf("Portfolio of %d solvers\n", portfolio.size());
+			}
+		}
 		fflush(stdout);
 		//exit(0);
 		double after_preprocessing =  rtime(0);
@@ -652,7 +1426,36 @@ int main(int argc, char** argv) {
 			printf("solving:\n");
 			fflush(stdout);
 		}
-		lbool ret = S.solve(assume) ? l_True : l_False;
+		lbool ret;
+		SimpSolver * result_solver = &S;
+		if (conquering) {
+			if (portfolio.size() == 0)
+				portfolio.push(&S);
+			int winner = conquer(portfolio, cubes, assume, ret);
+			if (winner >= 0) {
+				result_solver = portfolio[winner];
+				selectPortfolioAlgorithms(winner, opt_reach_alg, opt_maxflow_alg, opt_dist_alg);
+				if (opt_verb > 0 && portfolio.size() > 1) {
+					printf("Cube worker %d finished first\n", winner);
+				}
+			}
+		} else if (portfolio.size() > 1) {
+			int winner = solvePortfolio(portfolio, assume, ret);
+			if (winner >= 0) {
+				result_solver = portfolio[winner];
+				//the statistics of the winning copy refer to its own choice of graph algorithms
+				selectPortfolioAlgorithms(winner, opt_reach_alg, opt_maxflow_alg, opt_dist_alg);
+				if (opt_verb > 0) {
+					printf("Portfolio solver %d finished first\n", winner);
+				}
+			}
+		} else {
+			//(an interrupted search, such as one stopped by SIGTERM after a checkpoint, is UNKNOWN, not UNSATISFIABLE)
+			S.budgetOff();
+			ret = S.solveLimited(assume);
+		}
+		SimpSolver & R = *result_solver;
+		S.closeProof();
 		double solving_time = rtime(0) - after_preprocessing;
 		if (opt_verb > 0) {
 			printf("Solving time = %f\n", solving_time);
@@ -664,10 +1467,10 @@ int main(int argc, char** argv) {
 				FILE * f = fopen(opt_witness_file, "w");
 				if (f) {
 					fprintf(f, "v ");
-					for (int v = 0; v < S.nVars(); v++) {
-						if (S.model[v] == l_True) {
+					for (int v = 0; v < R.nVars(); v++) {
+						if (R.model[v] == l_True) {
 							fprintf(f, "%d ", (v + 1));
-						} else if (S.model[v] == l_False) {
+						} else if (R.model[v] == l_False) {
 							fprintf(f, "%d ", -(v + 1));
 						}
 					}
@@ -681,14 +1484,14 @@ int main(int argc, char** argv) {
 			if (strlen(opt_theory_witness_file) > 0) {
 				std::cout<<"Writing witness to file " << (const char*) opt_theory_witness_file <<"\n";
 				std::ofstream theory_out(opt_theory_witness_file, ios::out);
-				S.writeTheoryWitness(theory_out);
+				R.writeTheoryWitness(theory_out);
 				for (auto p : symbols) {
 					Var v = p.first;
 					string & s = p.second;
-					if (S.model[v] == l_True) {
+					if (R.model[v] == l_True) {
 						theory_out<< "var "<<  s <<"\n";
 
-					} else if (S.model[v] == l_False) {
+					} else if (R.model[v] == l_False) {
 						//theory_out<< "-"<<  s <<"\n";
 					} else {
 						//this is unassigned
@@ -700,10 +1503,10 @@ int main(int argc, char** argv) {
 			if (opt_witness) {
 
 				printf("v ");
-				for (int v = 0; v < S.nVars(); v++) {
-					if (S.model[v] == l_True) {
+				for (int v = 0; v < R.nVars(); v++) {
+					if (R.model[v] == l_True) {
 						printf("%d ", (v + 1));
-					} else if (S.model[v] == l_False) {
+					} else if (R.model[v] == l_False) {
 						printf("%d ", -(v + 1));
 					}
 				}
@@ -716,10 +1519,10 @@ int main(int argc, char** argv) {
 				for (auto p : symbols) {
 					Var v = p.first;
 					string & s = p.second;
-					if (S.model[v] == l_True) {
+					if (R.model[v] == l_True) {
 						fprintf(sfile, ":- not %s.\n", s.c_str());
 						//cout<<":- not "<< s<<".\n";
-					} else if (S.model[v] == l_False) {
+					} else if (R.model[v] == l_False) {
 						fprintf(sfile, ":- %s.\n", s.c_str());
 						//cout<<":- "<<s<<".\n";
 					} else {
@@ -736,10 +1539,10 @@ int main(int argc, char** argv) {
 				for (auto p : symbols) {
 					Var v = p.first;
 					std::string & s = p.second;
-					if (S.model[v] == l_True) {
+					if (R.model[v] == l_True) {
 						printf("%s ", s.c_str());
 						//cout<<":- not "<< s<<".\n";
-					} else if (S.model[v] == l_False) {
+					} else if (R.model[v] == l_False) {
 						printf("-%s ", s.c_str());
 						//cout<<":- "<<s<<".\n";
 					}
@@ -747,8 +1550,8 @@ int main(int argc, char** argv) {
 				printf("\n");
 			}
 			if (opt_verb > 2) {
-				for (int i = 0; i < S.theories.size(); i++)
-					S.theories[i]->printSolution();
+				for (int i = 0; i < R.theories.size(); i++)
+					R.theories[i]->printSolution();
 			}
 			if (!opt_csv)
 				printf("s SATISFIABLE\n");
@@ -758,7 +1561,7 @@ int main(int argc, char** argv) {
 			printf("UNKNOWN\n");
 		}
 		if (opt_verb > 1) {
-			printStats(S);
+			printStats(R);
 
 		}
 		fflush(stdout);
@@ -769,5 +1572,8 @@ int main(int argc, char** argv) {
 		printf("===============================================================================\n");
 		printf("INDETERMINATE\n");
 		exit(0);
+	} catch (ParseError & e) {
+		printf("PARSE ERROR! %s\n", e.message.c_str());
+		exit(e.status);
 	}
 }
@@ -60,15 +60,20 @@ public:
 				if (parsed_var == 0)
 					break;
 				if(parsed_var<0){
-					fprintf(stderr,"at-most-one constraints currently only accept variables (eg, must be >0), not literals, but found %d\n",parsed_var);
-					exit(1);
+					parseError(1, "at-most-one constraints currently only accept variables (eg, must be >0), not literals, but found %d",parsed_var);
 				}
 				Var var = parsed_var-1;
 				while (var >= S.nVars())
 					S.newVar();
 				vars.push(var);
 			}
-			if(vars.size()>1){
+			if(vars.size()>1 && this->activation!=lit_Undef){
+				//the theory cannot be switched off, so a scoped constraint is added as pairwise clauses instead
+				for (int i = 0; i < vars.size(); i++) {
+					for (int j = i + 1; j < vars.size(); j++)
+						S.addClause(~this->activation, ~mkLit(vars[i]), ~mkLit(vars[j]));
+				}
+			}else if(vars.size()>1){
 				//else this constraint has no effect
 				AMOTheory * amo = new AMOTheory(&S);
 				for (Var v : vars)
@@ -100,6 +100,9 @@ public:
 			conflict_var=var_Undef;
 		}
 	}
+	bool supportsChronologicalBacktracking() {
+		return true;
+	}
 	void enqueueTheory(Lit l) {
 		if(conflict_var==var_Undef){
 			if (!sign(l)){
@@ -193,6 +193,12 @@ void * newSolver(int argc, char**argv){
 	  Monosat::SimpSolver * S = new Monosat::SimpSolver();
 
 	  S->_external_data =(void*)new MonosatData();
+	  if (strlen(opt_proof) > 0) {
+		  std::string formula_file =
+				  strlen(opt_proof_formula) > 0 ? (const char*) opt_proof_formula : std::string(opt_proof) + ".cnf";
+		  if (!S->openProof(opt_proof, formula_file.c_str(), opt_proof_binary))
+			  fprintf(stderr, "Error: could not open proof file %s\n", (const char*) opt_proof);
+	  }
 	  if(!opt_pre){
 		  S->eliminate(true);//disable preprocessing.
 	  }
@@ -208,6 +214,7 @@ void deleteSolver (Monosat::SimpSolver * S)
 }
 
 void * newGraph(Monosat::SimpSolver * S){
+	  backtrack(S);
 	  MonosatData * d = (MonosatData*) S->_external_data;
 	  Monosat::GraphTheorySolver<long> *graph = new Monosat::GraphTheorySolver<long>(S);
 	  S->addTheory(graph);
@@ -223,10 +230,13 @@ bool solve(Monosat::SimpSolver * S){
 	  ignore.clear();
 	return solveAssumptions(S,&ignore[0],0);
   }
+//Return to level 0. Every function here that changes the formula calls this first, as (with -reuse-trail)
+//a solve can return above level 0, keeping the levels of its assumptions for the next solve.
 void backtrack(Monosat::SimpSolver * S){
 	S->cancelUntil(0);
 }
 void * initBVTheory(Monosat::SimpSolver * S){
+	  backtrack(S);
 	MonosatData * d = (MonosatData*) S->_external_data;
 	if(d->bv_theory)
 		return d->bv_theory;
@@ -240,11 +250,14 @@ void * initBVTheory(Monosat::SimpSolver * S){
 	  return bv;
 }
 bool solveAssumptions(Monosat::SimpSolver * S,int * assumptions, int n_assumptions){
-	S->cancelUntil(0);
-
-	  static Monosat::vec<Monosat::Lit> assume;
+	  //Clauses and constraints can only be added at level 0 (see backtrack()); so if the solver is still above level 0,
+	  //it is unchanged since the last call, and (with -reuse-trail) it can keep the levels of the assumptions shared with that call.
+	  if(!opt_reuse_trail || S->decisionLevel()==0){
+		S->cancelUntil(0);
 		S->preprocess();//do this _even_ if sat based preprocessing is disabled! Some of the theory solvers depend on a preprocessing call being made!
 		S->eliminate(true);
+	  }
+	  static Monosat::vec<Monosat::Lit> assume;
 	  assume.clear();
 	  for (int i = 0;i<n_assumptions;i++){
 		  assume.push(toLit(assumptions[i]));
@@ -258,6 +271,7 @@ bool solveAssumptions(Monosat::SimpSolver * S,int * assumptions, int n_assumptio
  }
 
  int newVar(Monosat::SimpSolver * S){
+	  backtrack(S);
 	  return S->newVar();
  }
 
@@ -279,6 +293,7 @@ bool solveAssumptions(Monosat::SimpSolver * S,int * assumptions, int n_assumptio
  }
 
  bool addClause(Monosat::SimpSolver * S,int * lits, int n_lits){
+	  backtrack(S);
 	  static vec<Lit> clause;
 	  clause.clear();
 	  for (int i = 0;i<n_lits;i++){
@@ -287,21 +302,26 @@ bool solveAssumptions(Monosat::SimpSolver * S,int * assumptions, int n_assumptio
 	  return S->addClause(clause);
  }
  bool addUnitClause(Monosat::SimpSolver * S,int lit){
+	  backtrack(S);
 	  return S->addClause(toLit(lit));
  }
  bool addBinaryClause(Monosat::SimpSolver * S,int lit1, int lit2){
+	  backtrack(S);
 	  return S->addClause(toLit(lit1),toLit(lit2));
  }
  bool addTertiaryClause(Monosat::SimpSolver * S,int lit1, int lit2, int lit3){
+	  backtrack(S);
 	  return S->addClause(toLit(lit1),toLit(lit2),toLit(lit3));
  }
 
  //theory interface for bitvectors
 
  int newBitvector_const(Monosat::SimpSolver * S, Monosat::BVTheorySolver<long> * bv, int bvWidth, long constval){
+	  backtrack(S);
 	 return bv->newBitvector(-1,bvWidth,constval).getID();
  }
  int newBitvector(Monosat::SimpSolver * S, Monosat::BVTheorySolver<long> * bv, int * bits, int n_bits){
+	  backtrack(S);
 	  static vec<Var> lits;
 	  lits.clear();
 	  for (int i = 0;i<n_bits;i++){
@@ -363,12 +383,14 @@ bool solveAssumptions(Monosat::SimpSolver * S,int * assumptions, int n_assumptio
  }
 
  void bv_addition( Monosat::SimpSolver * S, Monosat::BVTheorySolver<long> * bv, int bvID1, int bvID2, int resultID){
+	  backtrack(S);
 	  bv->newAdditionBV(resultID,bvID1,bvID2);
  }
 
  //simple at-most-one constraint: asserts that at most one of the set of variables (NOT LITERALS) may be true.
  //for small numbers of variables, consider using a direct CNF encoding instead
  void at_most_one(Monosat::SimpSolver * S, int * vars, int n_vars){
+	  backtrack(S);
 	 if(n_vars>1){
 		 AMOTheory* amo = new  AMOTheory(S);
 		 for(int i = 0;i<n_vars;i++){
@@ -381,6 +403,7 @@ bool solveAssumptions(Monosat::SimpSolver * S,int * assumptions, int n_assumptio
  //theory interface for graphs
 
  int newNode(Monosat::SimpSolver * S,Monosat::GraphTheorySolver<long> *G){
+	  backtrack(S);
 	  return G->newNode();
  }
  int newEdge(Monosat::SimpSolver * S, Monosat::GraphTheorySolver<long> *G,int from,int  to,  long weight){
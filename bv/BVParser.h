@@ -54,6 +54,7 @@ private:
 		int width=0;
 		long constval=-1;
 		vec<Var> vector;
+		bool implemented=false;
 	};
 	vec<BV> bvs;
 
@@ -104,7 +105,7 @@ private:
 
 		if(bvs[id].id!=-1){
 
-			printf("PARSE ERROR! Re-defined bitvector %d\n", id), exit(1);
+			parseError(1, "Re-defined bitvector %d", id);
 
 		}
 		bvs[id].id = id;
@@ -122,7 +123,7 @@ private:
 
 		if(bvs[id].id!=-1){
 
-			printf("PARSE ERROR! Re-defined bitvector %d\n", id), exit(1);
+			parseError(1, "Re-defined bitvector %d", id);
 
 		}
 		bvs[id].id = id;
@@ -143,8 +144,12 @@ private:
 		}
 		skipWhitespace(in);
 	/*	if(! match(in,"bv")){
-			printf("PARSE ERROR! Result of addition must be bitvector\n"), exit(1);
+			parseError(1, "Result of addition must be bitvector");
 		}*/
+		if(this->activation!=lit_Undef){
+			//(the addition would constrain its result bitvector, and would not be retracted by pop)
+			parseError(1, "Bitvector additions cannot be added inside a scope");
+		}
 		int resultID = parseInt(in);
 		skipWhitespace(in);
 		//bool arg1_is_bv=match(in,"bv");
@@ -189,7 +194,7 @@ private:
 			++in;
 		}
 		if (symbol.size() == 0) {
-			printf("PARSE ERROR! Empty symbol: %c\n", *in), exit(1);
+			parseError(1, "Empty symbol: %c", *in);
 		}
 		/*   		if(symbols && used_symbols.count(symbol)){
 		 printf("PARSE ERROR! Duplicated symbol: %c\n", *symbol.c_str()), exit(1);
@@ -334,11 +339,14 @@ public:
 
 	void implementConstraints(Solver & S) {
 		if(bvs.size()){
-			theory = new BVTheorySolver<long>(&S);
+			//(this may be called again, for bitvectors and comparisons that are added between solves)
+			if(!theory)
+				theory = new BVTheorySolver<long>(&S);
 
 
 			for (auto & bv:bvs){
-				if(bv.id>-1){
+				if(bv.id>-1 && !bv.implemented){
+					bv.implemented=true;
 					if(bv.constval>=0){
 						theory->newBitvector(bv.id,bv.width,bv.constval);
 					}else{
@@ -378,10 +386,17 @@ public:
 					fprintf(stderr,"Unmatched bv symbol definition for %d : %s\n",bvID,s.c_str());
 				}
 			}
+			compares.clear();
+			comparebvs.clear();
+			addbvs.clear();
+			symbols.clear();
 
 		}else if (addbvs.size() || comparebvs.size() || compares.size()){
-
-			printf("PARSE ERROR! Undefined bitvector\n"), exit(1);
+			//(drop them, so that they are not implemented with the constraints that are added later)
+			compares.clear();
+			comparebvs.clear();
+			addbvs.clear();
+			parseError(1, "Undefined bitvector");
 
 		}
 
@@ -1330,6 +1330,9 @@ public:
 		
 	}
 
+	bool supportsChronologicalBacktracking() {
+		return true;
+	}
 	void enqueueTheory(Lit l) {
 		Var v = var(l);
 		rewind_trail_pos(trail.size());
@@ -4854,7 +4857,7 @@ template<typename Weight>
 Weight BVTheorySolver<Weight>::refine_ubound_check(int bvID, Weight bound, Var ignore_bit){
 #ifndef NDEBUG
 	//test all values of mbits, find the lowest one >= i
-	static vec<Weight> vals;
+	static thread_local vec<Weight> vals;
 	vals.clear();
 
     dbg_evaluate(bvID,bitvectors[bvID].size()-1,vals,0);
@@ -4874,7 +4877,7 @@ template<typename Weight>
 Weight BVTheorySolver<Weight>::refine_lbound_check(int bvID, Weight bound, Var ignore_bit){
 #ifndef NDEBUG
 	//test all values of mbits, find the lowest one >= i
-	static vec<Weight> vals;
+	static thread_local vec<Weight> vals;
 	vals.clear();
 
     dbg_evaluate(bvID,bitvectors[bvID].size()-1,vals,0);
@@ -85,14 +85,14 @@ static void parse_Assumptions(gzFile input_stream, vec<Lit>& assumptions, Solver
 				}
 				if (symbol.size() > 0) {
 					if (symbol_table.count(symbol) == 0) {
-						printf("PARSE ERROR! Unknown symbol: %s\n", symbol.c_str()), exit(3);
+						parseError(3, "Unknown symbol: %s", symbol.c_str());
 					} else {
 						int v = symbol_table[symbol];
 						Lit l = mkLit(v, neg);
 						assumptions.push(l);
 					}
 				} else {
-					printf("PARSE ERROR! Empty symbol!\n"), exit(3);
+					parseError(3, "Empty symbol!");
 				}
 				
 			}
@@ -124,6 +124,36 @@ static void parse_Assumptions(gzFile input_stream, vec<Lit>& assumptions, Solver
 	}
 //=================================================================================================
 }
+
+//Cubes, as written by -cube (one per line, in the iCNF style 'a <lit> ... <lit> 0').
+template<class Solver>
+static void parse_Cubes(gzFile input_stream, vec<vec<Lit>>& cubes, Solver& S) {
+	StreamBuffer in(input_stream);
+	for (;;) {
+		skipWhitespace(in);
+		if (*in == EOF)
+			break;
+		else if (*in == 'c' || *in == 'p')
+			skipLine(in);
+		else if (*in == 'a') {
+			++in;
+			cubes.push();
+			for (;;) {
+				Lit l = readLit(in);
+				if (l == lit_Error)
+					break;
+				if (var(l) >= S.nVars()) {
+					fprintf(stderr, "Bad cube literal %d: %d is larger than the largest variable in the GNF\n", dimacs(l),
+							var(l) + 1);
+					exit(1);
+				}
+				cubes.last().push(l);
+			}
+		} else {
+			parseError(3, "Unexpected char in cube file: %c", *in);
+		}
+	}
+}
 }
 ;
 
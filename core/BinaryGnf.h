@@ -0,0 +1,371 @@
+/****************************************************************************************[BinaryGnf.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef BINARY_GNF_H_
+#define BINARY_GNF_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <zlib.h>
+#include "utils/ParseUtils.h"
+
+namespace Monosat {
+
+/**
+ * Binary gnf: a pre-tokenized form of a gnf file, for instances that are loaded many times (written by 'monosat -gnf2bin').
+ *
+ * The file is a header and a table of sections, followed by the sections, each 8-byte aligned and in host byte order:
+ *   - Clauses: the literals of each clause line (in DIMACS numbering), each clause followed by 0 (int32_t[])
+ *   - Graphs:  declarations of integer weighted graphs, as (graph id, nodes) pairs (int32_t[2][n])
+ *   - Edges:   the edges of integer weighted graphs, as columns of graph ids, sources, targets, edge variables
+ *              (in DIMACS numbering) and weights (int32_t[n] each)
+ *   - Reaches: reachability atoms, as (graph id, from, to, variable) tuples (int32_t[4][n])
+ *   - Lines:   all other lines (bitvector definitions, other theory atoms, symbols, ...) as text, each 0-terminated (char[])
+ *   - Order:   the order of the lines of the original file, as runs of (section kind, number of records) pairs (uint32_t[2][n])
+ * The loader ('Dimacs::parse_binary()') walks the runs, adding the records of each section directly from the mapped file,
+ * so that the solver and theories are built exactly as they would be from the text. It checks the graph, node and variable
+ * ids of the graph, edge and reachability records (every edge must be in a graph declared by the graph section).
+ *
+ * Only clauses, integer weighted graphs, their edges and reachability atoms are pre-tokenized, and the records keep the
+ * order of the text (the edges are not grouped by graph or by node). Everything else - bitvector definitions, all other
+ * theory atoms, symbols, and any edge with a weight that does not fit in 32 bits - stays in the lines section, and is
+ * re-parsed by the text parsers when the file is loaded, so it loads no faster than from gnf text.
+ */
+struct BinaryGnfHeader {
+	static const uint64_t Magic = 0x42464e475441534dULL; //"MSATGNFB"
+	static const uint32_t Version = 1;
+	uint64_t magic;
+	uint32_t version;
+	uint32_t n_sections;
+};
+
+struct BinaryGnfSection {
+	enum Kind {
+		Clauses = 1, Graphs = 2, Edges = 3, Reaches = 4, Lines = 5, Order = 6
+	};
+	uint32_t kind;
+	uint32_t reserved;
+	uint64_t offset; //bytes from the start of the file
+	uint64_t size;   //bytes
+	uint64_t records;
+};
+
+static inline bool isBinaryGnf(const char * data, size_t size) {
+	uint64_t magic;
+	if (size < sizeof(BinaryGnfHeader))
+		return false;
+	memcpy(&magic, data, sizeof(magic));
+	return magic == BinaryGnfHeader::Magic;
+}
+
+//The sections of a binary gnf file, in place.
+struct BinaryGnfReader {
+	const int32_t * clauses = nullptr;
+	const int32_t * graphs = nullptr;
+	const int32_t * edges = nullptr;
+	const int32_t * reaches = nullptr;
+	const char * lines = nullptr;
+	const uint32_t * order = nullptr;
+	uint64_t n_records[7] = { 0 };
+	uint64_t n_clause_words = 0;
+	uint64_t n_line_bytes = 0;
+
+	//Returns null on success, and otherwise a description of what is wrong with the file.
+	const char * open(const char * data, size_t size) {
+		if (!isBinaryGnf(data, size))
+			return "not a binary gnf file";
+		const BinaryGnfHeader * header = (const BinaryGnfHeader*) data;
+		if (header->version != BinaryGnfHeader::Version)
+			return "unsupported binary gnf version (convert the input again)";
+		if (header->n_sections > (size - sizeof(BinaryGnfHeader)) / sizeof(BinaryGnfSection))
+			return "truncated section table";
+		const BinaryGnfSection * table = (const BinaryGnfSection*) (data + sizeof(BinaryGnfHeader));
+		for (uint32_t i = 0; i < header->n_sections; i++) {
+			const BinaryGnfSection & s = table[i];
+			if (s.offset % 8 != 0 || s.offset > size || s.size > size - s.offset)
+				return "section out of bounds";
+			const char * begin = data + s.offset;
+			switch (s.kind) {
+			case BinaryGnfSection::Clauses:
+				clauses = (const int32_t*) begin;
+				n_clause_words = s.size / sizeof(int32_t);
+				if (n_clause_words > 0 && clauses[n_clause_words - 1] != 0)
+					return "unterminated clause";
+				if (n_clause_words < s.records)
+					return "clause section too small";
+				break;
+			case BinaryGnfSection::Graphs:
+				graphs = (const int32_t*) begin;
+				if (s.size != s.records * 2 * sizeof(int32_t))
+					return "wrong graph section size";
+				break;
+			case BinaryGnfSection::Edges:
+				edges = (const int32_t*) begin;
+				if (s.size != s.records * 5 * sizeof(int32_t))
+					return "wrong edge section size";
+				break;
+			case BinaryGnfSection::Reaches:
+				reaches = (const int32_t*) begin;
+				if (s.size != s.records * 4 * sizeof(int32_t))
+					return "wrong reach section size";
+				break;
+			case BinaryGnfSection::Lines:
+				lines = begin;
+				n_line_bytes = s.size;
+				if (s.size > 0 && lines[s.size - 1] != 0)
+					return "unterminated line";
+				if (s.size < s.records)
+					return "line section too small";
+				break;
+			case BinaryGnfSection::Order:
+				order = (const uint32_t*) begin;
+				if (s.size != s.records * 2 * sizeof(uint32_t))
+					return "wrong order section size";
+				break;
+			default:
+				continue; //(sections of later minor versions can be skipped)
+			}
+			n_records[s.kind] = s.records;
+		}
+		//every record must be referred to exactly once by the runs of the order section
+		uint64_t referred[7] = { 0 };
+		for (uint64_t i = 0; i < n_records[BinaryGnfSection::Order]; i++) {
+			uint32_t kind = order[2 * i];
+			if (kind < BinaryGnfSection::Clauses || kind > BinaryGnfSection::Lines)
+				return "bad record kind in order section";
+			referred[kind] += order[2 * i + 1];
+		}
+		for (int kind = BinaryGnfSection::Clauses; kind <= BinaryGnfSection::Lines; kind++) {
+			if (referred[kind] != n_records[kind])
+				return "order section does not match the sections";
+		}
+		return nullptr;
+	}
+};
+
+/**
+ * Converts gnf text to binary gnf. Clause lines, declarations and edges of integer weighted graphs, and reachability atoms
+ * are stored tokenized; any other line (or any of those that is not in the plain form that these sections can represent
+ * exactly, such as an edge with a weight outside of int32_t) is stored as text, and is parsed as usual when the binary
+ * file is loaded.
+ */
+class BinaryGnfWriter {
+	std::vector<int32_t> clauses;
+	std::vector<int32_t> graphs;
+	std::vector<int32_t> edge_columns[5];
+	std::vector<int32_t> reaches;
+	std::vector<char> lines;
+	std::vector<uint32_t> order;
+	uint64_t n_records[7] = { 0 };
+	enum GraphKind : char {
+		Undeclared = 0, Integer, Other
+	};
+	std::vector<char> graph_kinds;
+	std::vector<int> tmp;
+
+	void record(uint32_t kind) {
+		n_records[kind]++;
+		if (order.size() && order[order.size() - 2] == kind) {
+			order.back()++;
+		} else {
+			order.push_back(kind);
+			order.push_back(1);
+		}
+	}
+	GraphKind graphKind(int g) const {
+		return (g >= 0 && g < (int) graph_kinds.size()) ? (GraphKind) graph_kinds[g] : Undeclared;
+	}
+	void setGraphKind(int g, GraphKind kind) {
+		if (g < 0)
+			return;
+		if (g >= (int) graph_kinds.size())
+			graph_kinds.resize(g + 1, Undeclared);
+		graph_kinds[g] = kind;
+	}
+	static bool startsWith(const char * p, const char * eol, const char * word) {
+		size_t n = strlen(word);
+		return (size_t) (eol - p) >= n && strncmp(p, word, n) == 0;
+	}
+	static bool onlyWhitespace(const char * p, const char * eol) {
+		while (p < eol && isWhitespace(*p))
+			p++;
+		return p >= eol;
+	}
+	//Read n integers (as the text parsers would), returning false if there are not n plain integers.
+	static bool readInts(const char *& p, const char * eol, int * vals, int n) {
+		for (int i = 0; i < n; i++) {
+			if (!parseIntBounded(p, eol, vals[i]))
+				return false;
+		}
+		return true;
+	}
+
+	//'digraph [int] <nodes> <edges> <graph>'
+	bool addGraph(const char * p, const char * eol) {
+		p += strlen("digraph");
+		while (p < eol && isWhitespace(*p))
+			p++;
+		bool integer = true;
+		if (startsWith(p, eol, "int"))
+			p += 3;
+		else if (startsWith(p, eol, "float") || startsWith(p, eol, "rational"))
+			integer = false, p += (*p == 'f') ? 5 : 8;
+		int vals[3];
+		if (!readInts(p, eol, vals, 3))
+			return false;
+		int n = vals[0], g = vals[2];
+		if (!integer || !onlyWhitespace(p, eol) || n < 0 || graphKind(g) != Undeclared) {
+			setGraphKind(g, Other);
+			return false;
+		}
+		setGraphKind(g, Integer);
+		graphs.push_back(g);
+		graphs.push_back(n);
+		record(BinaryGnfSection::Graphs);
+		return true;
+	}
+	//'edge <graph> <from> <to> <var> [weight]', in an integer weighted graph
+	bool addEdge(const char * p, const char * eol) {
+		p++; //(the parser skips the character after the keyword)
+		int vals[5];
+		if (!readInts(p, eol, vals, 4) || graphKind(vals[0]) != Integer || vals[1] < 0 || vals[2] < 0 || vals[3] < 1)
+			return false;
+		vals[4] = 1;
+		if (!onlyWhitespace(p, eol) && (!readInts(p, eol, vals + 4, 1) || !onlyWhitespace(p, eol)))
+			return false;
+		for (int i = 0; i < 5; i++)
+			edge_columns[i].push_back(vals[i]);
+		record(BinaryGnfSection::Edges);
+		return true;
+	}
+	//'reach <graph> <from> <to> <var>'
+	bool addReach(const char * p, const char * eol) {
+		p++;
+		int vals[4];
+		if (!readInts(p, eol, vals, 4) || !onlyWhitespace(p, eol) || graphKind(vals[0]) == Undeclared || vals[1] < 0
+				|| vals[2] < 0 || vals[3] < 1)
+			return false;
+		reaches.insert(reaches.end(), vals, vals + 4);
+		record(BinaryGnfSection::Reaches);
+		return true;
+	}
+
+	template<class T>
+	static void putSection(FILE * f, std::vector<BinaryGnfSection> & table, uint32_t kind, uint64_t records,
+			const std::vector<T> & data) {
+		BinaryGnfSection s;
+		s.kind = kind;
+		s.reserved = 0;
+		s.offset = ftell(f);
+		s.size = data.size() * sizeof(T);
+		s.records = records;
+		table.push_back(s);
+		fwrite(data.data(), sizeof(T), data.size(), f);
+		static const char padding[8] = { 0 };
+		fwrite(padding, 1, (8 - s.size % 8) % 8, f);
+	}
+
+public:
+	//Add one line of gnf text, from its first non-whitespace character up to and including its newline (if it has one).
+	void addLine(const char * b, const char * e) {
+		const char * eol = (e > b && e[-1] == '\n') ? e - 1 : e;
+		if ((*b >= '0' && *b <= '9') || *b == '-' || *b == '+') {
+			tmp.clear();
+			if (tokenizeClause(b, eol, tmp)) {
+				clauses.insert(clauses.end(), tmp.begin(), tmp.end());
+				record(BinaryGnfSection::Clauses);
+				return;
+			}
+		} else if (startsWith(b, eol, "digraph")) {
+			if (addGraph(b, eol))
+				return;
+		} else if ((startsWith(b, eol, "edge") || startsWith(b, eol, "weighted_edge")) && !startsWith(b, eol, "edge_")) {
+			const char * p = b + ((*b == 'e') ? 4 : 13);
+			if (p < eol && isWhitespace(*p) && addEdge(p, eol))
+				return;
+		} else if (startsWith(b, eol, "reach")) {
+			const char * p = b + 5;
+			if (p < eol && isWhitespace(*p) && addReach(p, eol))
+				return;
+		}
+		lines.insert(lines.end(), b, e);
+		lines.push_back(0);
+		record(BinaryGnfSection::Lines);
+	}
+
+	//Convert all of the (optionally gzipped) gnf text in 'input'.
+	void convert(gzFile input) {
+		StreamBuffer in(input);
+		std::vector<char> line;
+		for (;;) {
+			skipWhitespace(in);
+			if (*in == EOF)
+				break;
+			line.clear();
+			while (*in != EOF) {
+				char c = *in;
+				line.push_back(c);
+				++in;
+				if (c == '\n')
+					break;
+			}
+			addLine(line.data(), line.data() + line.size());
+		}
+	}
+
+	//Returns false if the file could not be written.
+	bool write(const char * filename) {
+		FILE * f = fopen(filename, "wb");
+		if (!f)
+			return false;
+		BinaryGnfHeader header;
+		header.magic = BinaryGnfHeader::Magic;
+		header.version = BinaryGnfHeader::Version;
+		header.n_sections = 6;
+		std::vector<BinaryGnfSection> table;
+		//the table is written once the section offsets are known
+		fseek(f, sizeof(BinaryGnfHeader) + header.n_sections * sizeof(BinaryGnfSection), SEEK_SET);
+		putSection(f, table, BinaryGnfSection::Clauses, n_records[BinaryGnfSection::Clauses], clauses);
+		putSection(f, table, BinaryGnfSection::Graphs, n_records[BinaryGnfSection::Graphs], graphs);
+		std::vector<int32_t> edges;
+		for (auto & column : edge_columns)
+			edges.insert(edges.end(), column.begin(), column.end());
+		putSection(f, table, BinaryGnfSection::Edges, n_records[BinaryGnfSection::Edges], edges);
+		putSection(f, table, BinaryGnfSection::Reaches, n_records[BinaryGnfSection::Reaches], reaches);
+		putSection(f, table, BinaryGnfSection::Lines, n_records[BinaryGnfSection::Lines], lines);
+		putSection(f, table, BinaryGnfSection::Order, order.size() / 2, order);
+		fseek(f, 0, SEEK_SET);
+		fwrite(&header, sizeof(header), 1, f);
+		fwrite(table.data(), sizeof(BinaryGnfSection), table.size(), f);
+		bool ok = !ferror(f);
+		return fclose(f) == 0 && ok;
+	}
+
+	uint64_t records(uint32_t kind) const {
+		return n_records[kind];
+	}
+};
+
+}
+
+#endif /* BINARY_GNF_H_ */
@@ -0,0 +1,136 @@
+/****************************************************************************************[ClauseExchange.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef CLAUSEEXCHANGE_H_
+#define CLAUSEEXCHANGE_H_
+
+#include <atomic>
+#include <cstdint>
+#include "mtl/Vec.h"
+#include "core/SolverTypes.h"
+
+namespace Monosat {
+
+/**
+ * Lock-free exchange of short clauses between the solvers of a portfolio.
+ * Each solver owns one fixed size ring buffer that only it writes to; every other solver reads that ring
+ * through its own private cursor, so there are no locks and no contention between writers.
+ * Slots are protected by a sequence number (a seqlock): if the writer laps a slow reader, the reader
+ * detects the overwritten slot and simply skips ahead, dropping the clauses it missed.
+ */
+class ClauseExchange {
+public:
+	static const int MaxClauseSize = 32;
+	static const int RingSize = 4096; //must be a power of two
+
+private:
+	struct Slot {
+		std::atomic<uint64_t> seq;
+		std::atomic<int> size;
+		std::atomic<int> lits[MaxClauseSize];
+		Slot() :
+				seq(0), size(0) {
+		}
+	};
+	struct Ring {
+		std::atomic<uint64_t> head;
+		Slot slots[RingSize];
+		Ring() :
+				head(0) {
+		}
+	};
+
+	vec<Ring*> rings;
+	std::atomic<int> winner;
+public:
+	ClauseExchange(int n_solvers) :
+			winner(-1) {
+		for (int i = 0; i < n_solvers; i++)
+			rings.push(new Ring());
+	}
+	~ClauseExchange() {
+		for (Ring * r : rings)
+			delete (r);
+	}
+
+	int nSolvers() const {
+		return rings.size();
+	}
+
+	//Publish a clause from solver 'producer'. Only the owning solver may call this for its ring.
+	bool publish(int producer, const vec<Lit> & clause) {
+		if (clause.size() > MaxClauseSize)
+			return false;
+		Ring & r = *rings[producer];
+		uint64_t h = r.head.load(std::memory_order_relaxed);
+		Slot & s = r.slots[h & (RingSize - 1)];
+		s.seq.store(2 * h + 1, std::memory_order_relaxed); //odd: write in progress
+		std::atomic_thread_fence(std::memory_order_release);
+		s.size.store(clause.size(), std::memory_order_relaxed);
+		for (int i = 0; i < clause.size(); i++)
+			s.lits[i].store(toInt(clause[i]), std::memory_order_relaxed);
+		s.seq.store(2 * h + 2, std::memory_order_release);
+		r.head.store(h + 1, std::memory_order_release);
+		return true;
+	}
+
+	//Read the next clause published by 'producer' after 'cursor' into 'out', advancing 'cursor'.
+	//Returns false if there is nothing new to read.
+	bool fetch(int producer, uint64_t & cursor, vec<Lit> & out) {
+		Ring & r = *rings[producer];
+		while (true) {
+			uint64_t h = r.head.load(std::memory_order_acquire);
+			if (cursor >= h)
+				return false;
+			if (h - cursor > RingSize)
+				cursor = h - RingSize; //the writer lapped us; skip the clauses we missed
+			uint64_t c = cursor++;
+			Slot & s = r.slots[c & (RingSize - 1)];
+			uint64_t s1 = s.seq.load(std::memory_order_acquire);
+			if (s1 != 2 * c + 2)
+				continue;
+			int sz = s.size.load(std::memory_order_relaxed);
+			if (sz < 0 || sz > MaxClauseSize)
+				continue;
+			out.clear();
+			for (int i = 0; i < sz; i++)
+				out.push(toLit(s.lits[i].load(std::memory_order_relaxed)));
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (s.seq.load(std::memory_order_relaxed) != s1)
+				continue; //overwritten while we were reading it
+			return true;
+		}
+	}
+
+	//Returns true if 'solver' is the first to finish; all later callers get false.
+	bool claimWin(int solver) {
+		int expected = -1;
+		return winner.compare_exchange_strong(expected, solver);
+	}
+	int getWinner() const {
+		return winner.load();
+	}
+};
+
+}
+;
+
+#endif /* CLAUSEEXCHANGE_H_ */
@@ -47,6 +47,14 @@ DoubleOption Monosat::opt_random_seed(_cat, "rnd-seed", "Used by the random vari
 		DoubleRange(0, false, HUGE_VAL, false));
 IntOption Monosat::opt_ccmin_mode(_cat, "ccmin-mode", "Controls conflict clause minimization (0=none, 1=basic, 2=deep)",
 		2, IntRange(0, 2));
+BoolOption Monosat::opt_shrink(_cat, "shrink",
+		"Replace the literals of each decision level in a learnt clause by the unique implication point of that level, where its reasons allow (all-UIP shrinking)",
+		false);
+BoolOption Monosat::opt_binary_min(_cat, "binary-min",
+		"Remove the literals of a learnt clause that are implied by the negation of its asserting literal through a binary clause",
+		false);
+BoolOption Monosat::opt_theory_conflict_min(_cat, "theory-conflict-min",
+		"Minimize theory conflict clauses with -ccmin-mode and -shrink, before they are learnt", false);
 IntOption Monosat::opt_phase_saving(_cat, "phase-saving",
 		"Controls the level of phase saving (0=none, 1=limited, 2=full)", 2, IntRange(0, 2));
 BoolOption Monosat::opt_rnd_init_act(_cat, "rnd-init", "Randomize the initial activity", false);
@@ -54,10 +62,61 @@ BoolOption Monosat::opt_luby_restart(_cat, "luby", "Use the Luby restart sequenc
 IntOption Monosat::opt_restart_first(_cat, "rfirst", "The base restart interval", 100, IntRange(1, INT32_MAX));
 DoubleOption Monosat::opt_restart_inc(_cat, "rinc", "Restart interval increase factor", 2,
 		DoubleRange(1, false, HUGE_VAL, false));
+BoolOption Monosat::opt_ema_restart(_cat, "ema-restart",
+		"Restart dynamically when the recent LBD of conflicts exceeds its long term average (instead of -luby or geometric restarts)",
+		false);
+DoubleOption Monosat::opt_restart_ema_fast(_cat, "restart-ema-fast",
+		"Smoothing factor of the fast moving average of conflict LBD (for -ema-restart)", 1.0 / 32,
+		DoubleRange(0, false, 1, true));
+DoubleOption Monosat::opt_restart_ema_slow(_cat, "restart-ema-slow",
+		"Smoothing factor of the slow moving average of conflict LBD and trail size (for -ema-restart)", 1.0 / 4096,
+		DoubleRange(0, false, 1, true));
+DoubleOption Monosat::opt_restart_margin(_cat, "restart-margin",
+		"Restart when the fast LBD average exceeds the slow average by this factor (for -ema-restart)", 1.25,
+		DoubleRange(1, true, HUGE_VAL, false));
+IntOption Monosat::opt_restart_min(_cat, "restart-min",
+		"Minimum number of conflicts between dynamic restarts (for -ema-restart)", 50, IntRange(1, INT32_MAX));
+DoubleOption Monosat::opt_restart_block(_cat, "restart-block",
+		"Postpone a dynamic restart if the trail is this much larger than its average (0 to disable blocking)", 1.4,
+		DoubleRange(0, true, HUGE_VAL, false));
+IntOption Monosat::opt_restart_block_start(_cat, "restart-block-start",
+		"Number of conflicts before restarts may be blocked (for -ema-restart)", 10000, IntRange(0, INT32_MAX));
+IntOption Monosat::opt_chrono_backtrack(_cat, "chrono",
+		"Backtrack chronologically (by a single level) after a conflict, if backjumping would undo more than this many levels (-1 to always backjump)",
+		-1, IntRange(-1, INT32_MAX));
+BoolOption Monosat::opt_vmtf(_cat, "vmtf",
+		"Pick decisions with the variable-move-to-front heuristic instead of VSIDS (decision priorities are still respected)", false);
+BoolOption Monosat::opt_target_phase(_cat, "target-phase",
+		"Decide with the phases of the largest conflict-free assignment seen since the last restart, instead of the saved phases",
+		false);
+IntOption Monosat::opt_rephase(_cat, "rephase",
+		"Reset the saved phases to the original, best, inverted or random phases after this many conflicts (the interval grows arithmetically; 0 to disable)",
+		0, IntRange(0, INT32_MAX));
+IntOption Monosat::opt_inprocess(_cat, "inprocess",
+		"Between restarts, after this many conflicts, remove satisfied and subsumed learnt clauses and vivify the remaining learnt clauses (0 to disable)",
+		0, IntRange(0, INT32_MAX));
+DoubleOption Monosat::opt_inprocess_time(_cat, "inprocess-time",
+		"Limit each round of -inprocess to this fraction of the time spent searching since the previous round", 0.1,
+		DoubleRange(0, false, 1, true));
+BoolOption Monosat::opt_theory_phase_hints(_cat, "theory-phase-hints",
+		"Let theories (such as reachability witnesses in graphs) suggest the phases of their literals when the best phases are updated",
+		false);
+BoolOption Monosat::opt_reuse_trail(_cat, "reuse-trail",
+		"Keep the decision levels of the longest common assumption prefix between incremental solves, if the solver is not modified in between",
+		false);
 DoubleOption Monosat::opt_garbage_frac(_cat, "gc-frac",
 		"The fraction of wasted memory allowed before a garbage collection is triggered", 0.20,
 		DoubleRange(0, false, HUGE_VAL, false));
+BoolOption Monosat::opt_gc_generational(_cat, "gc-generational",
+		"Garbage collect the clauses allocated since the last full collection (mostly learnt clauses) on their own, in place, instead of relocating all clauses",
+		true);
+IntOption Monosat::opt_gc_young_size(_cat, "gc-young-size",
+		"Promote the young generation of clauses to the old generation once it holds this many megabytes of live clauses (bounding the pause of each young collection; 0 promotes it after every young collection)",
+		16, IntRange(0, 4095));
 BoolOption Monosat::opt_pre("MAIN", "pre", "Completely turn on/off any preprocessing.", true);
+IntOption Monosat::opt_parse_threads("MAIN", "parse-threads",
+		"Number of threads tokenizing uncompressed input files, which are memory mapped (0 to read all input through zlib)", 1,
+		IntRange(0, 64));
 IntOption Monosat::opt_time(_cat, "verb-time", "Detail level of timing benchmarks (these add some overhead)", 0,
 		IntRange(0, 5));
 
@@ -72,6 +131,28 @@ DoubleOption Monosat::opt_random_theory_freq(_cat, "rnd-theory-freq",
 BoolOption Monosat::opt_early_theory_prop(_cat, "early-theory-prop",
 		"If false, the solver waits until all literals are propagated before propagating theories; if true, theories are propagated while the solver is still propagating literals",
 		false);
+BoolOption Monosat::opt_theory_schedule(_cat, "theory-schedule",
+		"Propagate theories in order of their measured conflict/implication yield per unit of propagation time, instead of last-in first-out",
+		false);
+DoubleOption Monosat::opt_theory_early_cost(_cat, "theory-early-cost",
+		"With -theory-schedule, theories whose average propagation time is below this many microseconds are propagated while the solver is still propagating literals (others wait until it is done)",
+		20, DoubleRange(0, true, HUGE_VAL, false));
+StringOption Monosat::opt_trace_file(_cat, "trace-file",
+		"Record a timeline of search, theory propagation and graph algorithm updates, and write it to this file at exit (in Chrome Trace Event format; empty to disable)",
+		"");
+IntOption Monosat::opt_trace_buffer(_cat, "trace-buffer",
+		"Number of trace events kept per thread (for -trace-file; older events are dropped)", 1 << 20, IntRange(1, INT32_MAX));
+StringOption Monosat::opt_proof(_cat, "proof",
+		"Write a DRAT proof of unsatisfiability to this file (empty to disable)", "");
+StringOption Monosat::opt_proof_formula(_cat, "proof-formula",
+		"File to write the formula that the -proof refers to (the input clauses and the theory lemmas); defaults to the proof file name with '.cnf' appended",
+		"");
+BoolOption Monosat::opt_proof_binary(_cat, "proof-binary", "Write the -proof in binary DRAT (instead of text DRAT)", true);
+#ifdef MONOSAT_PROFILE
+StringOption Monosat::opt_profile_file(_cat, "profile-file",
+		"File to write theory and detector profiles to, at exit and on SIGUSR1 (empty for stderr)", "monosat_profile.json");
+StringOption Monosat::opt_profile_format(_cat, "profile-format", "Format of the profile (json, csv)", "json");
+#endif
 
 BoolOption Monosat::opt_amo_eager_prop(_cat_amo,"amo-eager-prop","Propagate a-m-o literals as soon as they are implied, instead of waiting for theory propagation",true);
 
@@ -156,6 +237,14 @@ BoolOption Monosat::opt_force_directed(_cat_graph, "force-directed",
 		false);
 
 BoolOption Monosat::opt_rnd_restart(_cat, "rnd-restart", "Randomize activity on restart", false);
+IntOption Monosat::opt_lbd_core(_cat, "lbd-core",
+		"Learnt clauses with a literal block distance of at most this are never deleted", 2, IntRange(0, INT32_MAX));
+IntOption Monosat::opt_lbd_tier2(_cat, "lbd-tier2",
+		"Learnt clauses with a literal block distance of at most this are kept for as long as they are used in conflict analysis",
+		6, IntRange(0, INT32_MAX));
+IntOption Monosat::opt_portfolio_share_size(_cat, "portfolio-share-size",
+		"In portfolio mode, the maximum size of learnt clauses that are shared with the other solvers", 8,
+		IntRange(1, 32));
 
 IntOption Monosat::opt_learn_reaches(_cat_graph, "learn-reach",
 		"Learn using reach variables: 0 = Never, 1=Paths, 2=Cuts,3=Always", 0, IntRange(0, 3));
@@ -26,18 +26,42 @@
 namespace Monosat {
 extern IntOption opt_verb;
 extern BoolOption opt_pre;
+extern IntOption opt_parse_threads;
 extern DoubleOption opt_var_decay;
 extern DoubleOption opt_clause_decay;
 extern DoubleOption opt_random_var_freq;
 extern DoubleOption opt_random_seed;
 extern IntOption opt_ccmin_mode;
 extern IntOption opt_phase_saving;
+extern BoolOption opt_shrink;
+extern BoolOption opt_binary_min;
+extern BoolOption opt_theory_conflict_min;
 extern BoolOption opt_rnd_init_act;
 extern BoolOption opt_luby_restart;
 extern IntOption opt_restart_first;
 extern DoubleOption opt_restart_inc;
+extern BoolOption opt_ema_restart;
+extern DoubleOption opt_restart_ema_fast;
+extern DoubleOption opt_restart_ema_slow;
+extern DoubleOption opt_restart_margin;
+extern IntOption opt_restart_min;
+extern DoubleOption opt_restart_block;
+extern IntOption opt_restart_block_start;
+extern IntOption opt_chrono_backtrack;
+extern BoolOption opt_reuse_trail;
+extern BoolOption opt_vmtf;
+extern BoolOption opt_target_phase;
+extern IntOption opt_rephase;
+extern IntOption opt_inprocess;
+extern DoubleOption opt_inprocess_time;
+extern BoolOption opt_theory_phase_hints;
 extern DoubleOption opt_garbage_frac;
+extern BoolOption opt_gc_generational;
+extern IntOption opt_gc_young_size;
 extern BoolOption opt_rnd_restart;
+extern IntOption opt_lbd_core;
+extern IntOption opt_lbd_tier2;
+extern IntOption opt_portfolio_share_size;
 
 extern IntOption opt_theory_conflict_max;
 extern DoubleOption opt_random_theory_freq;
@@ -123,6 +147,17 @@ extern BoolOption opt_detect_pure_lits;
 extern BoolOption opt_propagate_theories_during_simplification;
 extern BoolOption opt_shrink_theory_conflicts;
 extern BoolOption opt_early_theory_prop;
+extern BoolOption opt_theory_schedule;
+extern DoubleOption opt_theory_early_cost;
+extern StringOption opt_trace_file;
+extern IntOption opt_trace_buffer;
+extern StringOption opt_proof;
+extern StringOption opt_proof_formula;
+extern BoolOption opt_proof_binary;
+#ifdef MONOSAT_PROFILE
+extern StringOption opt_profile_file;
+extern StringOption opt_profile_format;
+#endif
 extern IntOption opt_width;
 extern IntOption opt_height;
 extern IntOption opt_bits;
@@ -28,8 +28,15 @@
 #include "utils/ParseUtils.h"
 #include "core/SolverTypes.h"
 #include "mtl/Vec.h"
+#include "core/BinaryGnf.h"
 #include <string>
+#include <vector>
 #include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
 namespace Monosat {
 
 template<class B, class Solver>
@@ -41,12 +48,21 @@ public:
 	}
 	virtual bool parseLine(B& in, Solver& S)=0;
 	virtual void implementConstraints(Solver & S)=0;
+	//Whether this parser accepts more lines after its constraints have been implemented (for input added between solves).
+	virtual bool supportsIncrementalInput() const {
+		return true;
+	}
+
+	//The activation literal of the innermost open scope (see 'Dimacs::push()'), or lit_Undef if there is none.
+	//Constraints that do more than define fresh variables must only hold while it is true.
+	Lit activation = lit_Undef;
 };
 
 //A simple parser to allow for named variables
 template<class B, class Solver>
 class SymbolParser: public Parser<B, Solver> {
-	vec<std::pair<int, std::string> >  symbols;
+	//(this is a std::vector, as vec relocates its elements with realloc, which is not safe for std::string)
+	std::vector<std::pair<int, std::string> >  symbols;
 	std::string symbol;
 public:
 	SymbolParser(){
@@ -76,16 +92,16 @@ public:
 					++in;
 				}
 				if (symbol.size() == 0) {
-					printf("PARSE ERROR! Empty symbol: %c\n", *in), exit(1);
+					parseError(1, "Empty symbol: %c", *in);
 				}
 				/*   		if(symbols && used_symbols.count(symbol)){
 				 printf("PARSE ERROR! Duplicated symbol: %c\n", *symbol.c_str()), exit(1);
 				 }
 				 used_symbols.insert(symbol);*/
 
-				symbols.push();
-				symbols.last().first = v;
-				symbols.last().second = symbol;
+				symbols.emplace_back();
+				symbols.back().first = v;
+				symbols.back().second = symbol;
 				return true;
 			} else {
 				//just a comment
@@ -105,9 +121,9 @@ public:
 				symbols[j++] = symbols[i];
 			}
 		}
-		symbols.shrink(i - j);
+		symbols.resize(j);
 	}
-	vec<std::pair<int, std::string> > &  getSymbols(){
+	std::vector<std::pair<int, std::string> > &  getSymbols(){
 		return symbols;
 	}
 };
@@ -116,6 +132,13 @@ public:
 template<class B, class Solver>
 class Dimacs {
 	vec<Parser<char*, Solver>*> parsers;
+	vec<bool> has_input; //for each parser, whether it has parsed a line since its constraints were last implemented
+	bool implemented = false;
+	vec<Lit> scopes; //the activation literals of the open scopes, innermost last
+	//the header, and the number of clause lines, of the input
+	int vars = 0;
+	int clauses = 0;
+	int cnt = 0;
 public:
 	Dimacs() {
 		
@@ -141,14 +164,39 @@ private:
 	}
 	
 	virtual bool parseLine(const char * line, Solver& S) {
-		for (auto * p : parsers) {
+		for (int i = 0; i < parsers.size(); i++) {
 			char * ln = (char*) line; //intentionally discard const qualifier
-			if (p->parseLine(ln, S)) {
+			if (parsers[i]->parseLine(ln, S)) {
+				if (implemented && !parsers[i]->supportsIncrementalInput())
+					parseError(1, "Constraint can only be added with the initial input: %.*s", (int) strcspn(line, "\n"), line);
+				has_input[i] = true;
 				return true;
 			}
 		}
 		return false;
 	}
+
+	//Implement the constraints of every parser the first time; afterwards (for input added between solves),
+	//only those of the parsers that have parsed a line since. If a parser rejects its constraints, those of the other
+	//parsers are still implemented, before its ParseError is passed on.
+	void implementConstraints(Solver& S) {
+		std::unique_ptr<ParseError> error;
+		for (int i = 0; i < parsers.size(); i++) {
+			bool pending = !implemented || has_input[i];
+			has_input[i] = false;
+			if (!pending)
+				continue;
+			try {
+				parsers[i]->implementConstraints(S);
+			} catch (ParseError & e) {
+				if (!error)
+					error.reset(new ParseError(e));
+			}
+		}
+		implemented = true;
+		if (error)
+			throw *error;
+	}
 	
 	bool readLine(vec<char> & linebuf, B& in) {
 		linebuf.clear();
@@ -168,37 +216,66 @@ private:
 		return true;
 	}
 	
+	//Handle one (0-terminated) line of input.
+	void parseBufferedLine(vec<char> & linebuf, Solver& S, vec<Lit> & lits) {
+		if (parseLine(linebuf.begin(), S)) {
+			//do nothing
+		} else if (linebuf[0] == 'p') {
+			char * b = linebuf.begin();
+			if (eagerMatch(b, "p cnf")) {
+				vars = parseInt(b);
+				clauses = parseInt(b);
+			} else {
+				parseError(3, "Unexpected char: %c", *b);
+			}
+		} else if (linebuf[0] == 'c') {
+			//comment line
+			//skipLine(in);
+		} else {
+			//if nothing else works, attempt to parse this line as a clause.
+			cnt++;
+			readClause(linebuf.begin(), S, lits);
+			if (scopes.size())
+				lits.push(~scopes.last());
+			S.addClause_(lits);
+		}
+	}
+
+	//Handle the line [b, e) (which includes its newline, if it has one) of a mapped file.
+	void parseMappedLine(const char * b, const char * e, vec<char> & linebuf, Solver& S, vec<Lit> & lits) {
+		linebuf.clear();
+		linebuf.growTo(e - b);
+		memcpy(linebuf.begin(), b, e - b);
+		linebuf.push(0);
+		parseBufferedLine(linebuf, S, lits);
+	}
+
+	//Add the clause of tokenized literals at 'lit' (terminated by 0), returning the literal after it.
+	template<class Int>
+	const Int * addTokenizedClause(const Int * lit, Solver& S, vec<Lit> & lits) {
+		lits.clear();
+		for (; *lit != 0; lit++) {
+			int var = abs(*lit) - 1;
+			while (var >= S.nVars())
+				S.newVar();
+			lits.push((*lit > 0) ? mkLit(var) : ~mkLit(var));
+		}
+		cnt++;
+		if (scopes.size())
+			lits.push(~scopes.last());
+		S.addClause_(lits);
+		return lit + 1;
+	}
+
 	void parse(B& in, Solver& S) {
 		vec<Lit> lits;
-		int vars = 0;
-		int clauses = 0;
-		int cnt = 0;
-		
 		vec<char> linebuf;
 		for (;;) {
 			skipWhitespace(in);
 			if (*in == EOF)
 				break;
 			readLine(linebuf, in);
-			if (parseLine(linebuf.begin(), S)) {
-				//do nothing
-			} else if (linebuf[0] == 'p') {
-				char * b = linebuf.begin();
-				if (eagerMatch(b, "p cnf")) {
-					vars = parseInt(b);
-					clauses = parseInt(b);
-				} else {
-					printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
-				}
-			} else if (linebuf[0] == 'c') {
-				//comment line
-				//skipLine(in);
-			} else {
-				//if nothing else works, attempt to parse this line as a clause.
-				cnt++;
-				readClause(linebuf.begin(), S, lits);
-				S.addClause_(lits);
-			}
+			parseBufferedLine(linebuf, S, lits);
 		}
 		//Disabling this for now, as it is always triggered when there are theory atoms...
 		/*if (vars != S.nVars())
@@ -206,19 +283,265 @@ private:
 		if (cnt != clauses)
 			fprintf(stderr, "WARNING! DIMACS header mismatch: wrong number of clauses.\n");*/
 		
-		for (auto * p : parsers) {
-			p->implementConstraints(S);
+		implementConstraints(S);
+	}
+
+	//A line-aligned part of a memory mapped input file (see 'parse_mapped()').
+	struct Chunk {
+		const char * begin;
+		const char * end;
+		int n_clauses = 0;
+		std::vector<int> lits;        //the literals of each clause line, each clause followed by 0
+		std::vector<const char*> lines; //the start and end of each other line, in order
+		std::vector<int> line_at;     //for each other line, the number of clause lines before it in this chunk
+		bool ready = false;
+	};
+	static const size_t ChunkSize = 1 << 22;
+
+	//Split a chunk into lines; clause lines are tokenized, all other lines are kept for the parsers.
+	static void tokenize(Chunk & c) {
+		const char * p = c.begin;
+		for (;;) {
+			while (p < c.end && isWhitespace(*p))
+				p++;
+			if (p >= c.end)
+				break;
+			const char * eol = (const char*) memchr(p, '\n', c.end - p);
+			if (!eol)
+				eol = c.end;
+			size_t n_lits = c.lits.size();
+			//(none of the parsers accept lines that start with a number)
+			if (((*p >= '0' && *p <= '9') || *p == '-' || *p == '+') && tokenizeClause(p, eol, c.lits)) {
+				c.n_clauses++;
+			} else {
+				c.lits.resize(n_lits);
+				c.line_at.push_back(c.n_clauses);
+				c.lines.push_back(p);
+				c.lines.push_back(eol);
+			}
+			p = eol + 1;
 		}
 	}
 public:
 	void addParser(Parser<char*, Solver> * parser) {
 		parsers.push(parser);
+		has_input.push(false);
+		parser->activation = scopes.size() ? scopes.last() : lit_Undef;
+	}
+
+	/**
+	 * Open a scope, for input that is parsed between solves: until the matching 'pop()', the clauses that are parsed
+	 * (and the constraints of parsers that support scopes) only hold while 'activation' is true, so the caller must
+	 * assume all of the open scopes' literals when solving. Definitions of fresh variables (such as edges and theory atoms)
+	 * are not scoped.
+	 */
+	void push(Lit activation) {
+		scopes.push(activation);
+		for (auto * parser : parsers)
+			parser->activation = activation;
+	}
+	//Close the innermost scope, and return its activation literal (which the caller should then assign false for good).
+	Lit pop() {
+		assert(scopes.size());
+		Lit activation = scopes.last();
+		scopes.pop();
+		for (auto * parser : parsers)
+			parser->activation = scopes.size() ? scopes.last() : lit_Undef;
+		return activation;
+	}
+	const vec<Lit> & openScopes() const {
+		return scopes;
+	}
+	//The number of variables in the 'p cnf' header of the input (0 if it has none).
+	int headerVars() const {
+		return vars;
 	}
 	// Inserts problem into solver.
 	void parse_DIMACS(gzFile input_stream, Solver& S) {
 		StreamBuffer in(input_stream);
 		parse(in, S);
 	}
+
+	/**
+	 * Inserts the problem in the (uncompressed) text 'data[0..size)', such as a memory mapped file, into the solver.
+	 * The text is split into line-aligned chunks, which 'threads' threads tokenize in parallel (a bounded number of
+	 * chunks ahead), while the calling thread adds their clauses to the solver and passes all other lines to the parsers,
+	 * in file order; so the result is identical to that of 'parse_DIMACS()'. If 'threads' is 0, the calling thread
+	 * tokenizes the chunks itself (as for small inputs, such as the fragments added between solves).
+	 */
+	void parse_mapped(const char * data, size_t size, Solver& S, int threads) {
+		std::vector<Chunk> chunks;
+		const char * end = data + size;
+		for (const char * p = data; p < end;) {
+			const char * e = p + std::min(ChunkSize, (size_t) (end - p));
+			if (e < end) {
+				const char * eol = (const char*) memchr(e, '\n', end - e);
+				e = eol ? eol + 1 : end;
+			}
+			chunks.emplace_back();
+			chunks.back().begin = p;
+			chunks.back().end = e;
+			p = e;
+		}
+
+		std::mutex mutex;
+		std::condition_variable cond;
+		size_t next = 0;
+		size_t consumed = 0;
+		const size_t window = 4 * threads;
+		std::vector<std::thread> workers;
+		for (int t = 0; t < threads; t++) {
+			workers.emplace_back([&]() {
+				for (;;) {
+					size_t i;
+					{
+						std::unique_lock<std::mutex> lock(mutex);
+						cond.wait(lock, [&] {return next >= chunks.size() || next < consumed + window;});
+						if (next >= chunks.size())
+							return;
+						i = next++;
+					}
+					tokenize(chunks[i]);
+					{
+						std::lock_guard<std::mutex> lock(mutex);
+						chunks[i].ready = true;
+					}
+					cond.notify_all();
+				}
+			});
+		}
+
+		vec<Lit> lits;
+		vec<char> linebuf;
+		try {
+			for (size_t i = 0; i < chunks.size(); i++) {
+				Chunk & c = chunks[i];
+				if (threads <= 0) {
+					tokenize(c);
+				} else {
+					std::unique_lock<std::mutex> lock(mutex);
+					cond.wait(lock, [&] {return c.ready;});
+				}
+				const int * lit = c.lits.data();
+				int clause = 0;
+				for (size_t k = 0; k <= c.line_at.size(); k++) {
+					int until = k < c.line_at.size() ? c.line_at[k] : c.n_clauses;
+					for (; clause < until; clause++)
+						lit = addTokenizedClause(lit, S, lits);
+					if (k < c.line_at.size()) {
+						const char * e = c.lines[2 * k + 1];
+						parseMappedLine(c.lines[2 * k], e < end ? e + 1 : e, linebuf, S, lits);
+					}
+				}
+				std::vector<int>().swap(c.lits);
+				std::vector<const char*>().swap(c.lines);
+				std::vector<int>().swap(c.line_at);
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					consumed = i + 1;
+				}
+				cond.notify_all();
+			}
+		} catch (ParseError &) {
+			//stop the workers, and implement the lines before the malformed one, before passing the error on
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				next = chunks.size();
+			}
+			cond.notify_all();
+			for (auto & t : workers)
+				t.join();
+			implementConstraints(S);
+			throw;
+		}
+		for (auto & t : workers)
+			t.join();
+
+		implementConstraints(S);
+	}
+
+	/**
+	 * Inserts the problem in a (memory mapped) binary gnf file (see core/BinaryGnf.h) into the solver.
+	 * Clauses are added, and graphs, edges and reachability atoms are passed to 'graphs' (the graph parser),
+	 * directly from the sections of the file; the remaining lines are parsed as text. All in the order of the original file.
+	 */
+	template<class GraphParser>
+	void parse_binary(const char * data, size_t size, Solver& S, GraphParser & graphs) {
+		BinaryGnfReader gnf;
+		const char * error = gnf.open(data, size);
+		if (error)
+			parseError(3, "Bad binary gnf file: %s", error);
+
+		const int32_t * clause = gnf.clauses;
+		const int32_t * clauses_end = gnf.clauses + gnf.n_clause_words;
+		const int32_t * graph = gnf.graphs;
+		const int32_t * reach = gnf.reaches;
+		const char * line = gnf.lines;
+		const char * lines_end = gnf.lines + gnf.n_line_bytes;
+		uint64_t n_edges = gnf.n_records[BinaryGnfSection::Edges];
+		uint64_t edge = 0;
+		vec<Lit> lits;
+		vec<char> linebuf;
+		//the graphs declared in the graph section (edges are only stored for those; nodes are added as edges need them)
+		std::vector<char> declared;
+		auto isDeclared = [&](int g) {
+			return g >= 0 && g < (int) declared.size() && declared[g];
+		};
+		for (uint64_t r = 0; r < gnf.n_records[BinaryGnfSection::Order]; r++) {
+			uint32_t count = gnf.order[2 * r + 1];
+			switch (gnf.order[2 * r]) {
+			case BinaryGnfSection::Clauses:
+				for (uint32_t i = 0; i < count; i++) {
+					if (clause >= clauses_end)
+						parseError(3, "Bad binary gnf file: missing clauses");
+					clause = addTokenizedClause(clause, S, lits);
+				}
+				break;
+			case BinaryGnfSection::Graphs:
+				for (uint32_t i = 0; i < count; i++, graph += 2) {
+					int g = graph[0], n = graph[1];
+					if (g < 0 || n < 0 || isDeclared(g))
+						parseError(3, "Bad binary gnf file: bad declaration of graph %d", g);
+					if (g >= (int) declared.size())
+						declared.resize(g + 1, 0);
+					declared[g] = 1;
+					graphs.newGraph(g, n, S);
+				}
+				break;
+			case BinaryGnfSection::Edges:
+				for (uint32_t i = 0; i < count; i++, edge++) {
+					const int32_t * e = gnf.edges + edge;
+					int g = e[0], from = e[n_edges], to = e[2 * n_edges], var = e[3 * n_edges];
+					if (!isDeclared(g))
+						parseError(3, "Bad binary gnf file: edge %d in undeclared graph %d", var, g);
+					if (from < 0 || to < 0 || var < 1)
+						parseError(3, "Bad binary gnf file: bad edge %d %d %d %d", g, from, to, var);
+					graphs.newEdge(g, from, to, var - 1, e[4 * n_edges], S);
+				}
+				break;
+			case BinaryGnfSection::Reaches:
+				for (uint32_t i = 0; i < count; i++, reach += 4) {
+					//(the graph may also have been declared by a text line, which newReach checks)
+					int g = reach[0], from = reach[1], to = reach[2], var = reach[3];
+					if (from < 0 || to < 0 || var < 1)
+						parseError(3, "Bad binary gnf file: bad reachability atom %d %d %d %d", g, from, to, var);
+					graphs.newReach(g, from, to, var - 1, S);
+				}
+				break;
+			case BinaryGnfSection::Lines:
+				for (uint32_t i = 0; i < count; i++) {
+					if (line >= lines_end)
+						parseError(3, "Bad binary gnf file: missing lines");
+					size_t n = strlen(line);
+					parseMappedLine(line, line + n, linebuf, S, lits);
+					line += n + 1;
+				}
+				break;
+			}
+		}
+
+		implementConstraints(S);
+	}
 	
 };
 }
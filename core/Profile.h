@@ -0,0 +1,231 @@
+/****************************************************************************************[Profile.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+/**
+ * Instrumentation of the theory solver hot paths (propagation, solving, reason construction, backtracking and decisions),
+ * per theory and per detector.
+ *
+ * Profiling is only compiled in if MONOSAT_PROFILE is defined (e.g., add -DMONOSAT_PROFILE to the compiler flags);
+ * otherwise MONOSAT_PROFILE_SCOPE expands to nothing, and none of the code below is built.
+ *
+ * When compiled in, call counts, total wall time and a histogram of call durations (in power-of-two nanosecond buckets)
+ * are written to -profile-file (in -profile-format, json or csv) when the process exits, and whenever it receives SIGUSR1.
+ */
+
+#ifdef MONOSAT_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <vector>
+#include <cxxabi.h>
+#include <signal.h>
+#include "core/Config.h"
+
+namespace Monosat {
+
+enum class ProfileEvent {
+	Propagate, Solve, Reason, Backtrack, Decide, NumEvents
+};
+
+class Profiler {
+public:
+	static const int NumBuckets = 40; //bucket i counts calls that took [2^i, 2^(i+1)) nanoseconds
+	static const int NumEvents = (int) ProfileEvent::NumEvents;
+
+	struct Counter {
+		uint64_t calls = 0;
+		double seconds = 0;
+		uint64_t histogram[NumBuckets] = { };
+	};
+	//A profiled object (a theory or a detector). Each site is only ever updated by the thread that owns the object.
+	struct Site {
+		std::string name;
+		Counter counters[NumEvents];
+	};
+
+	static Site * addSite(const std::string & name) {
+		Profiler & p = get();
+		std::lock_guard<std::mutex> lock(p.mutex);
+		p.sites.emplace_back(new Site());
+		p.sites.back()->name = name;
+		return p.sites.back().get();
+	}
+
+	static void record(Site * site, ProfileEvent e, std::chrono::steady_clock::duration elapsed) {
+		Counter & c = site->counters[(int) e];
+		uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+		int bucket = 0;
+		while (bucket < NumBuckets - 1 && (ns >> (bucket + 1)))
+			bucket++;
+		c.calls++;
+		c.seconds += std::chrono::duration<double>(elapsed).count();
+		c.histogram[bucket]++;
+	}
+
+	//Write the profile if SIGUSR1 was received since the last call. Call this from a safe point in the solver.
+	static void poll() {
+		if (dump_requested().exchange(false, std::memory_order_relaxed))
+			write();
+	}
+
+	static void write() {
+		Profiler & p = get();
+		std::lock_guard<std::mutex> lock(p.mutex);
+		const char * fname = opt_profile_file;
+		FILE * f = (fname && strlen(fname)) ? fopen(fname, "w") : stderr;
+		if (!f) {
+			fprintf(stderr, "Could not open profile file %s\n", fname);
+			return;
+		}
+		if (strcmp(opt_profile_format, "csv") == 0)
+			p.writeCSV(f);
+		else
+			p.writeJSON(f);
+		if (f != stderr)
+			fclose(f);
+		else
+			fflush(f);
+	}
+
+	//Readable (demangled) name of the dynamic type of 'object', for naming sites.
+	template<class T>
+	static std::string typeName(T & object) {
+		const char * mangled = typeid(object).name();
+		int status = 0;
+		char * demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+		std::string name = (status == 0 && demangled) ? demangled : mangled;
+		free(demangled);
+		return name;
+	}
+
+	static const char * eventName(int e) {
+		static const char * names[] = { "propagate", "solve", "reason", "backtrack", "decide" };
+		return names[e];
+	}
+
+private:
+	std::mutex mutex;
+	std::vector<std::unique_ptr<Site>> sites;
+
+	static std::atomic<bool> & dump_requested() {
+		static std::atomic<bool> requested(false);
+		return requested;
+	}
+	static void onSIGUSR1(int) {
+		dump_requested().store(true, std::memory_order_relaxed);
+	}
+
+	Profiler() {
+		signal(SIGUSR1, onSIGUSR1);
+		atexit(write);
+	}
+	static Profiler & get() {
+		static Profiler * p = new Profiler(); //never destroyed, as it is written to from an atexit() handler
+		return *p;
+	}
+
+	void writeJSON(FILE * f) {
+		fprintf(f, "{\"sites\": [");
+		for (size_t i = 0; i < sites.size(); i++) {
+			Site & s = *sites[i];
+			fprintf(f, "%s\n  {\"name\": \"%s\", \"events\": {", i ? "," : "", s.name.c_str());
+			bool first = true;
+			for (int e = 0; e < NumEvents; e++) {
+				Counter & c = s.counters[e];
+				if (!c.calls)
+					continue;
+				fprintf(f, "%s\n    \"%s\": {\"calls\": %" PRIu64 ", \"seconds\": %f, \"histogram_log2_ns\": [", first ? "" : ",",
+						eventName(e), c.calls, c.seconds);
+				first = false;
+				int last = NumBuckets - 1;
+				while (last > 0 && !c.histogram[last])
+					last--;
+				for (int b = 0; b <= last; b++)
+					fprintf(f, "%s%" PRIu64, b ? ", " : "", c.histogram[b]);
+				fprintf(f, "]}");
+			}
+			fprintf(f, "}}");
+		}
+		fprintf(f, "\n]}\n");
+	}
+
+	void writeCSV(FILE * f) {
+		fprintf(f, "site,event,calls,seconds");
+		for (int b = 0; b < NumBuckets; b++)
+			fprintf(f, ",lt_2^%d_ns", b + 1);
+		fprintf(f, "\n");
+		for (auto & s : sites) {
+			for (int e = 0; e < NumEvents; e++) {
+				Counter & c = s->counters[e];
+				if (!c.calls)
+					continue;
+				fprintf(f, "\"%s\",%s,%" PRIu64 ",%f", s->name.c_str(), eventName(e), c.calls, c.seconds);
+				for (int b = 0; b < NumBuckets; b++)
+					fprintf(f, ",%" PRIu64, c.histogram[b]);
+				fprintf(f, "\n");
+			}
+		}
+	}
+};
+
+//Records the time from its construction to its destruction in 'site'.
+class ProfileScope {
+	Profiler::Site * site;
+	ProfileEvent event;
+	std::chrono::steady_clock::time_point start;
+public:
+	ProfileScope(Profiler::Site * site, ProfileEvent event) :
+			site(site), event(event), start(std::chrono::steady_clock::now()) {
+	}
+	~ProfileScope() {
+		Profiler::record(site, event, std::chrono::steady_clock::now() - start);
+	}
+};
+
+}
+
+#define MONOSAT_PROFILE_CONCAT_(a, b) a##b
+#define MONOSAT_PROFILE_CONCAT(a, b) MONOSAT_PROFILE_CONCAT_(a, b)
+//Profile the rest of the enclosing scope as an 'event' (a ProfileEvent) of 'site' (a Profiler::Site*).
+#define MONOSAT_PROFILE_SCOPE(site, event) \
+	Monosat::ProfileScope MONOSAT_PROFILE_CONCAT(profile_scope_, __LINE__)((site), Monosat::ProfileEvent::event)
+#define MONOSAT_PROFILE_POLL() Monosat::Profiler::poll()
+
+#else
+
+#define MONOSAT_PROFILE_SCOPE(site, event)
+#define MONOSAT_PROFILE_POLL()
+
+#endif
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,293 @@
+/****************************************************************************************[Proof.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef PROOF_H_
+#define PROOF_H_
+
+#include <cinttypes>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
+#include <cxxabi.h>
+#include "core/SolverTypes.h"
+
+namespace Monosat {
+
+/**
+ * A file that is written by a background thread.
+ * Bytes are appended to a buffer; full buffers are handed over to the writer thread, so that the solver
+ * only ever waits on the disk if it produces output faster than the disk can take it.
+ */
+class AsyncFile {
+	static const size_t BufferSize = 1 << 20;
+	FILE * file = nullptr;
+	std::vector<char> buffer;
+	std::vector<char> pending; //handed over to the writer thread
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::thread writer;
+	bool closing = false;
+
+	void run() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			cond.wait(lock, [this] {return closing || pending.size();});
+			if (pending.size()) {
+				lock.unlock();
+				fwrite(pending.data(), 1, pending.size(), file);
+				lock.lock();
+				pending.clear();
+				cond.notify_all();
+			} else if (closing) {
+				return;
+			}
+		}
+	}
+	void handOver() {
+		bytes += buffer.size();
+		std::unique_lock<std::mutex> lock(mutex);
+		cond.wait(lock, [this] {return pending.empty();});
+		std::swap(buffer, pending);
+		cond.notify_all();
+	}
+public:
+	uint64_t bytes = 0;
+
+	bool open(const char * filename) {
+		file = fopen(filename, "wb");
+		if (!file)
+			return false;
+		buffer.reserve(BufferSize);
+		pending.reserve(BufferSize);
+		writer = std::thread(&AsyncFile::run, this);
+		return true;
+	}
+	bool isOpen() const {
+		return file != nullptr;
+	}
+	~AsyncFile() {
+		close();
+	}
+
+	void put(char c) {
+		buffer.push_back(c);
+		if (buffer.size() >= BufferSize)
+			handOver();
+	}
+	void put(const char * s) {
+		while (*s)
+			put(*s++);
+	}
+	void putInt(int64_t n) {
+		char digits[24];
+		int i = 0;
+		uint64_t u = n < 0 ? -(uint64_t) n : n;
+		do {
+			digits[i++] = '0' + u % 10;
+			u /= 10;
+		} while (u);
+		if (n < 0)
+			put('-');
+		while (i)
+			put(digits[--i]);
+	}
+
+	//Wait for all output to be written, and stop the writer thread. Afterwards, the file is still open (see 'release()').
+	void flush() {
+		if (!file || !writer.joinable())
+			return;
+		handOver();
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			closing = true;
+			cond.notify_all();
+		}
+		writer.join();
+		fflush(file);
+	}
+	//Flush, and return the underlying file to the caller, who becomes responsible for closing it.
+	FILE * release() {
+		flush();
+		FILE * f = file;
+		file = nullptr;
+		return f;
+	}
+	void close() {
+		FILE * f = release();
+		if (f)
+			fclose(f);
+	}
+};
+
+/**
+ * DRAT proof output.
+ *
+ * The proof is written (in binary or text DRAT) to one file, and the formula it refers to is written to a second,
+ * DIMACS CNF file: this holds every clause given to the solver from outside (the input clauses, including the clauses that the
+ * theory solvers add while encoding their constraints), followed by the theory lemmas (the theory conflict and reason clauses).
+ * Theory lemmas cannot be derived by resolution, so they are written to the formula as trusted clauses,
+ * each preceded by a 'c theory <index> <type>' comment naming the theory that produced it.
+ * The proof can then be checked with a DRAT checker against that formula, e.g. 'drat-trim formula.cnf proof.drat'.
+ */
+class ProofWriter {
+	AsyncFile proof;
+	AsyncFile formula;
+	bool binary;
+	uint64_t n_formula_clauses = 0;
+	std::vector<std::string> theory_names;
+	static const int HeaderWidth = 48;
+
+	void putBinaryLit(Lit l) {
+		//binary DRAT maps the literal x (resp. -x) to 2x (resp. 2x+1), as a variable length unsigned integer.
+		uint32_t u = 2 * (var(l) + 1) + sign(l);
+		while (u > 127) {
+			proof.put((char) (128 | (u & 127)));
+			u >>= 7;
+		}
+		proof.put((char) u);
+	}
+	template<class C>
+	void putProofClause(const C & c, char kind) {
+		if (binary) {
+			proof.put(kind);
+			for (int i = 0; i < c.size(); i++)
+				putBinaryLit(c[i]);
+			proof.put((char) 0);
+		} else {
+			if (kind == 'd')
+				proof.put("d ");
+			for (int i = 0; i < c.size(); i++) {
+				proof.putInt(sign(c[i]) ? -(var(c[i]) + 1) : (var(c[i]) + 1));
+				proof.put(' ');
+			}
+			proof.put("0\n");
+		}
+	}
+	template<class C>
+	void putFormulaClause(const C & c) {
+		n_formula_clauses++;
+		for (int i = 0; i < c.size(); i++) {
+			formula.putInt(sign(c[i]) ? -(var(c[i]) + 1) : (var(c[i]) + 1));
+			formula.put(' ');
+		}
+		formula.put("0\n");
+	}
+	const std::string & theoryName(int theory, const std::type_info * type) {
+		static const std::string unknown = "unknown";
+		if (theory < 0 || !type)
+			return unknown;
+		if (theory >= (int) theory_names.size())
+			theory_names.resize(theory + 1);
+		std::string & name = theory_names[theory];
+		if (name.empty()) {
+			int status = 0;
+			char * demangled = abi::__cxa_demangle(type->name(), nullptr, nullptr, &status);
+			name = (status == 0 && demangled) ? demangled : type->name();
+			free(demangled);
+			for (char & c : name) {
+				if (c == ' ' || c == '\n')
+					c = '_';
+			}
+		}
+		return name;
+	}
+
+public:
+	uint64_t additions = 0;
+	uint64_t deletions = 0;
+	uint64_t inputs = 0;
+	uint64_t lemmas = 0;
+
+	ProofWriter(bool binary) :
+			binary(binary) {
+	}
+
+	//Returns false if either file could not be opened.
+	bool open(const char * proof_file, const char * formula_file) {
+		if (!proof.open(proof_file) || !formula.open(formula_file))
+			return false;
+		//the header is rewritten with the final clause and variable counts in 'close()'
+		for (int i = 0; i < HeaderWidth; i++)
+			formula.put(' ');
+		formula.put('\n');
+		return true;
+	}
+	bool isOpen() const {
+		return proof.isOpen();
+	}
+
+	template<class C>
+	void add(const C & c) {
+		additions++;
+		putProofClause(c, 'a');
+	}
+	template<class C>
+	void remove(const C & c) {
+		deletions++;
+		putProofClause(c, 'd');
+	}
+	template<class C>
+	void input(const C & c) {
+		inputs++;
+		putFormulaClause(c);
+	}
+	//A trusted lemma from the theory with the given index ('type' is the type of the theory solver; -1 and null if unknown).
+	template<class C>
+	void lemma(const C & c, int theory, const std::type_info * type) {
+		lemmas++;
+		formula.put("c theory ");
+		formula.putInt(theory);
+		formula.put(' ');
+		formula.put(theoryName(theory, type).c_str());
+		formula.put('\n');
+		putFormulaClause(c);
+	}
+
+	uint64_t bytesWritten() const {
+		return proof.bytes;
+	}
+
+	void close(int nVars) {
+		if (!proof.isOpen())
+			return;
+		proof.close();
+		FILE * f = formula.release();
+		if (f) {
+			fseek(f, 0, SEEK_SET);
+			fprintf(f, "p cnf %d %" PRIu64, nVars, n_formula_clauses);
+			fclose(f);
+		}
+	}
+	~ProofWriter() {
+		proof.close();
+		formula.close();
+	}
+};
+
+}
+
+#endif /* PROOF_H_ */
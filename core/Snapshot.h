@@ -0,0 +1,116 @@
+/****************************************************************************************[Snapshot.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef SNAPSHOT_H_
+#define SNAPSHOT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Monosat {
+
+/**
+ * Snapshots of the search state of a solver (see 'Solver::writeSnapshot()' and 'Solver::loadSnapshot()').
+ *
+ * A snapshot is a header, followed by these sections, each padded to a multiple of 8 bytes:
+ *   - the activity of each variable (double[n_vars])
+ *   - the saved, target and best phases of each variable (char[n_vars] each)
+ *   - the literals assigned at level 0 (uint32_t[n_units])
+ *   - the learnt clauses, in the word layout of the clause allocator (uint32_t[n_learnt_words])
+ *
+ * No theory state is part of the snapshot: resuming requires the original input, which is parsed again to rebuild the
+ * theories, and 'layout' (a hash of the input fingerprint, the variables and their theory atoms) ensures that the snapshot
+ * is only restored into a solver for the same input, with identical variables.
+ */
+struct SnapshotHeader {
+	static const uint64_t Magic = 0x31504e535441534dULL; //"MSATSNP1"
+	uint64_t magic;
+	uint32_t header_size;
+	uint32_t clause_header_size; //sizeof(Clause), as the learnt clauses are stored as raw clause allocator words
+	int32_t n_vars;
+	int32_t n_theories;
+	uint64_t layout;
+	uint64_t n_units;
+	uint64_t n_learnts;
+	uint64_t n_learnt_words;
+
+	uint64_t conflicts;
+	uint64_t decisions;
+	uint64_t propagations;
+	uint64_t starts;
+	uint64_t next_rephase;
+	uint64_t next_inprocess;
+	double var_inc;
+	double cla_inc;
+	int64_t target_assigned;
+	int64_t best_assigned;
+};
+
+static inline uint64_t snapshotPadding(uint64_t bytes) {
+	return (8 - (bytes % 8)) % 8;
+}
+
+//A read-only memory mapping of a whole file.
+class MappedFile {
+	void * data = MAP_FAILED;
+	size_t length = 0;
+public:
+	~MappedFile() {
+		close();
+	}
+	bool open(const char * filename) {
+		int fd = ::open(filename, O_RDONLY);
+		if (fd < 0)
+			return false;
+		struct stat st;
+		if (fstat(fd, &st) != 0 || st.st_size == 0) {
+			::close(fd);
+			return false;
+		}
+		length = st.st_size;
+		data = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close(fd);
+		if (data == MAP_FAILED)
+			return false;
+		madvise(data, length, MADV_SEQUENTIAL);
+		return true;
+	}
+	void close() {
+		if (data != MAP_FAILED)
+			munmap(data, length);
+		data = MAP_FAILED;
+		length = 0;
+	}
+	const char * bytes() const {
+		return (const char*) data;
+	}
+	size_t size() const {
+		return length;
+	}
+};
+
+}
+
+#endif /* SNAPSHOT_H_ */
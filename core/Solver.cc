@@ -28,8 +28,60 @@
 #include "core/Config.h"
 #include "graph/GraphTheory.h"
 #include <unistd.h>
+#include <chrono>
+#include <cstring>
+#include <typeinfo>
 using namespace Monosat;
 
+//=================================================================================================
+// Theory dispatch:
+
+/**
+ * The solver calls its theories through 'Theory*', so each propagation round makes several virtual calls per theory.
+ * Builds that define MONOSAT_THEORY_SET_GRAPH_BV (see ReleaseGraphBV/) fix a set of theory types at compile time:
+ * the calls in the propagation loop are made through a switch on 'theory_type', as qualified (non-virtual) calls to
+ * the exact theory type, which the compiler can inline. Theories of any other type are still called virtually.
+ */
+enum class TheoryType : char {
+	Other, Graph, BV
+};
+#ifdef MONOSAT_THEORY_SET_GRAPH_BV
+#define MONOSAT_THEORY_CALL(theoryID, call) \
+	(theory_type[theoryID] == (char) TheoryType::Graph ? \
+			static_cast<Monosat::GraphTheorySolver<long>*>(theories[theoryID])->Monosat::GraphTheorySolver<long>::call : \
+	theory_type[theoryID] == (char) TheoryType::BV ? \
+			static_cast<Monosat::BVTheorySolver<long>*>(theories[theoryID])->Monosat::BVTheorySolver<long>::call : \
+			theories[theoryID]->call)
+#else
+#define MONOSAT_THEORY_CALL(theoryID, call) (theories[theoryID]->call)
+#endif
+
+static TheoryType theoryType(Theory * t) {
+	//only the exact types can be called non-virtually (a subclass may override the calls)
+	if (typeid(*t) == typeid(Monosat::GraphTheorySolver<long> ))
+		return TheoryType::Graph;
+	else if (typeid(*t) == typeid(Monosat::BVTheorySolver<long> ))
+		return TheoryType::BV;
+	return TheoryType::Other;
+}
+
+void Solver::addTheory(Theory*t) {
+	theories.push(t);
+	decidable_theories.push(t);
+	theory_type.push((char) theoryType(t));
+	theory_queue.capacity(theories.size());
+	in_theory_queue.push(false);
+	theory_cost.push();
+#ifdef MONOSAT_PROFILE
+	theory_profile.push(Profiler::addSite(
+			(exchange_id >= 0 ? "solver " + std::to_string(exchange_id) + " " : std::string()) + "theory "
+					+ std::to_string(theories.size() - 1) + " (" + Profiler::typeName(*t) + ")"));
+#endif
+	t->setTheoryIndex(theories.size() - 1);
+	cancelUntil(0);
+	resetInitialPropagation();
+}
+
 //=================================================================================================
 // Options:
 // Collected in Config.h
@@ -42,9 +94,11 @@ Solver::Solver() :
 		// Parameters (user settable):
 		//
 		verbosity(opt_verb), var_decay(opt_var_decay), clause_decay(opt_clause_decay), random_var_freq(
-				opt_random_var_freq), random_seed(opt_random_seed), luby_restart(opt_luby_restart), ccmin_mode(
-				opt_ccmin_mode), phase_saving(opt_phase_saving), rnd_pol(false), rnd_init_act(opt_rnd_init_act), garbage_frac(
-				opt_garbage_frac), restart_first(opt_restart_first), restart_inc(opt_restart_inc)
+				opt_random_var_freq), random_seed(opt_random_seed), luby_restart(opt_luby_restart), ema_restart(opt_ema_restart), vmtf(opt_vmtf), target_phases(
+				opt_target_phase), theory_schedule(opt_theory_schedule), rephase_interval(opt_rephase), inprocess_interval(opt_inprocess), inprocess_time(opt_inprocess_time), ccmin_mode(
+				opt_ccmin_mode), shrink(opt_shrink), binary_min(opt_binary_min), theory_conflict_min(opt_theory_conflict_min), phase_saving(opt_phase_saving), rnd_pol(false), rnd_init_act(opt_rnd_init_act), garbage_frac(
+				opt_garbage_frac), generational_gc(opt_gc_generational), gc_young_words(
+				(uint32_t) opt_gc_young_size * (1024 * 1024 / ClauseAllocator::Unit_Size)), decide_theories(opt_decide_theories), restart_first(opt_restart_first), restart_inc(opt_restart_inc)
 
 		// Parameters (the rest):
 		//
@@ -59,19 +113,67 @@ Solver::Solver() :
 				, solves(0), starts(0), decisions(0), rnd_decisions(0), propagations(0), conflicts(0), stats_pure_lits(
 				0), stats_pure_theory_lits(0), pure_literal_detections(0), stats_removed_clauses(0), dec_vars(0), clauses_literals(
 				0), learnts_literals(0), max_literals(0), tot_literals(0), stats_pure_lit_time(0),  ok(
-				true), cla_inc(1), var_inc(1), watches(WatcherDeleted(ca)), qhead(0), simpDB_assigns(-1), simpDB_props(
+				true), cla_inc(1), var_inc(1), watches(WatcherDeleted(ca)), watches_bin(WatcherDeleted(ca)), qhead(0), simpDB_assigns(-1), simpDB_props(
 				0), order_heap(VarOrderLt(activity, priority)), progress_estimate(0), remove_satisfied(true) //lazy_heap( LazyLevelLt(this)),
 
 		// Resource constraints:
 		//
 				, conflict_budget(-1), propagation_budget(-1) {
-
+	if (strlen(opt_trace_file))
+		Trace::open(opt_trace_file, opt_trace_buffer);
 }
 
 Solver::~Solver() {
 	for (Theory * t : theories) {
 		delete (t);
 	}
+	if (proof) {
+		closeProof();
+		delete proof;
+	}
+}
+
+bool Solver::openProof(const char * proof_file, const char * formula_file, bool binary) {
+	assert(!proof);
+	proof = new ProofWriter(binary);
+	if (!proof->open(proof_file, formula_file)) {
+		delete proof;
+		proof = nullptr;
+		return false;
+	}
+	return true;
+}
+
+void Solver::closeProof() {
+	if (!proof || !proof->isOpen())
+		return;
+	if (!ok) {
+		proveLevelZero();
+		vec<Lit> empty;
+		proof->add(empty);
+	}
+	proof->close(nVars());
+}
+
+/*_________________________________________________________________________________________________
+ |
+ |  proveLevelZero : ()  ->  [void]
+ |
+ |  Description:
+ |    Clauses are simplified, and learnt clauses derived, without the literals that are false at level 0; a proof checker
+ |    can only derive those literals by unit propagation if the reasons of the theory propagations among them are in the
+ |    proof. As theory reasons are otherwise built lazily (and 'analyze()' never asks for those at level 0), build the
+ |    reasons of the theory literals on the level 0 trail, which logs them as lemmas. (This is only done once the
+ |    refutation is complete, as building a reason may leave a theory's state behind the solver's, which is only
+ |    repaired by backtracking; the lemmas are trusted input to the checker, so they need not precede their uses.)
+ |________________________________________________________________________________________________@*/
+void Solver::proveLevelZero() {
+	int end = decisionLevel() > 0 ? trail_lim[0] : trail.size();
+	for (int i = 0; i < end; i++) {
+		Lit p = trail[i];
+		if (isTheoryCause(reason(var(p))))
+			constructReason(p);
+	}
 }
 
 //=================================================================================================
@@ -85,6 +187,8 @@ Var Solver::newVar(bool sign, bool dvar) {
 	int v = nVars();
 	watches.init(mkLit(v, false));
 	watches.init(mkLit(v, true));
+	watches_bin.init(mkLit(v, false));
+	watches_bin.init(mkLit(v, true));
 	assigns.push(l_Undef);
 	vardata.push(mkVarData(CRef_Undef, 0));
 	int p = 0;
@@ -93,10 +197,17 @@ Var Solver::newVar(bool sign, bool dvar) {
 	if (v < min_decision_var)
 		p = 1;
 	priority.push(p);
+	if (vmtf)
+		vmtf_queue.insert(v, p);
 	theory_vars.push();
 	activity.push(rnd_init_act ? drand(random_seed) * 0.00001 : 0);
 	seen.push(0);
+	min_seen.push(0);
 	polarity.push(opt_init_rnd_phase ? irand(random_seed, 1) : sign);
+	original_phase.push(polarity.last());
+	target_phase.push(2);
+	best_phase.push(2);
+	best_stamp.push(0);
 	decision.push();
 	trail.capacity(v + 1);
 	if (max_decision_var > 0 && v > max_decision_var)
@@ -110,11 +221,13 @@ Var Solver::newVar(bool sign, bool dvar) {
 }
 
 bool Solver::addClause_(vec<Lit>& ps) {
-	
-
-	assert(decisionLevel() == 0);
+	//(with opt_reuse_trail, a solve can return above level 0; the clause would then be simplified against assumptions)
+	if (decisionLevel() > 0)
+		cancelUntil(0);
 	if (!ok)
 		return false;
+	if (proof)
+		proofClause(ps);
 	resetInitialPropagation();    //Ensure that super solver call propagate on this solver at least once.
 	// Check if clause is satisfied and remove false/duplicate literals:
 	sort(ps);
@@ -125,7 +238,11 @@ bool Solver::addClause_(vec<Lit>& ps) {
 			return true;
 		else if (value(ps[i]) != l_False && ps[i] != p)
 			ps[j++] = p = ps[i];
-	ps.shrink(i - j);
+	if (proof && i != j) {
+		ps.shrink(i - j);
+		proof->add(ps);
+	} else
+		ps.shrink(i - j);
 	
 	if (ps.size() == 0)
 		return ok = false;
@@ -161,6 +278,8 @@ CRef Solver::attachReasonClause(Lit r,vec<Lit> & ps) {
 		else if ((value(ps[i]) != l_False || level(var(ps[i])) != 0) && ps[i] != p)
 			ps[j++] = p = ps[i];
 	ps.shrink(i - j);
+	if (proof && i != j)
+		proof->add(ps);
 	
 	CRef confl_out = CRef_Undef;
 	if (ps.size() == 0) {
@@ -300,8 +419,9 @@ void Solver::attachClause(CRef cr) {
 			}
 		}
 #endif
-	watches[~c[0]].push(Watcher(cr, c[1]));
-	watches[~c[1]].push(Watcher(cr, c[0]));
+	OccLists<Lit, vec<Watcher>, WatcherDeleted> & ws = c.size() == 2 ? watches_bin : watches;
+	ws[~c[0]].push(Watcher(cr, c[1]));
+	ws[~c[1]].push(Watcher(cr, c[0]));
 	if (c.learnt())
 		learnts_literals += c.size();
 	else
@@ -312,13 +432,19 @@ void Solver::detachClause(CRef cr, bool strict) {
 	const Clause& c = ca[cr];
 	assert(c.size() > 1);
 	
+	OccLists<Lit, vec<Watcher>, WatcherDeleted> & ws = c.size() == 2 ? watches_bin : watches;
 	if (strict) {
-		remove(watches[~c[0]], Watcher(cr, c[1]));
-		remove(watches[~c[1]], Watcher(cr, c[0]));
+		remove(ws[~c[0]], Watcher(cr, c[1]));
+		remove(ws[~c[1]], Watcher(cr, c[0]));
 	} else {
 		// Lazy detaching: (NOTE! Must clean all watcher lists before garbage collecting this clause)
-		watches.smudge(~c[0]);
-		watches.smudge(~c[1]);
+		ws.smudge(~c[0]);
+		ws.smudge(~c[1]);
+		if (generational_gc && cr >= ca.young_start) {
+			vec<Lit> & smudged = c.size() == 2 ? young_smudged_bin : young_smudged;
+			smudged.push(~c[0]);
+			smudged.push(~c[1]);
+		}
 	}
 	
 	if (c.learnt())
@@ -329,10 +455,13 @@ void Solver::detachClause(CRef cr, bool strict) {
 
 void Solver::removeClause(CRef cr) {
 	Clause& c = ca[cr];
+	if (proof)
+		proof->remove(c);
 	detachClause(cr);
 	// Don't leave pointers to free'd memory!
-	if (locked(c))
-		vardata[var(c[0])].reason = CRef_Undef;
+	Lit l = lockedLit(c);
+	if (l != lit_Undef)
+		vardata[var(l)].reason = CRef_Undef;
 	c.mark(1);
 	ca.free(cr);
 }
@@ -354,7 +483,8 @@ void Solver::cancelUntil(int lev) {
 				//if we _are_ backtracking lazily, then the assumption is that the theory solver will, after backtracking, mostly re-assign the same literals.
 				//so instead, we will backtrack the theory lazily, in the future, if it encounters an apparent conflict (and this backtracking may alter or eliminate that conflict.)
 			}else{
-				theories[i]->backtrackUntil(lev);
+				MONOSAT_PROFILE_SCOPE(theory_profile[i], Backtrack);
+				MONOSAT_THEORY_CALL(i, backtrackUntil(lev));
 			}
 		}
 
@@ -367,7 +497,7 @@ void Solver::cancelUntil(int lev) {
 				to_reenqueue.push(trail[c]);
 			}else{
 				if(hasTheory(x)){
-					theories[getTheoryID(x)]->undecideTheory(getTheoryLit(trail[c]));
+					MONOSAT_THEORY_CALL(getTheoryID(x), undecideTheory(getTheoryLit(trail[c])));
 				}
 				assigns[x] = l_Undef;
 				if (phase_saving > 1 || ((phase_saving == 1) && c > trail_lim.last()))
@@ -376,6 +506,8 @@ void Solver::cancelUntil(int lev) {
 			}
 		}
 		qhead = trail_lim[lev];
+		if (trail_assumptions.size() > lev)
+			trail_assumptions.shrink(trail_assumptions.size() - lev);
 		if (local_qhead > qhead) {
 			local_qhead = qhead;
 		}
@@ -411,7 +543,7 @@ void Solver::cancelUntil(int lev) {
 			if (hasTheory(p)) {
 				int theoryID = getTheoryID(p);
 				needsPropagation(theoryID);
-				theories[theoryID]->enqueueTheory(getTheoryLit(p));
+				MONOSAT_THEORY_CALL(theoryID, enqueueTheory(getTheoryLit(p)));
 			}
 		}
 		//should qhead be adjusted, here? Or do we want to repropagate these literals? (currently, re-propagating these literals).
@@ -430,6 +562,18 @@ void Solver::backtrackUntil(int lev) {
 Lit Solver::pickBranchLit() {
 	Var next = var_Undef;
 	
+	if (vmtf) {
+		if (drand(random_seed) < random_var_freq) {
+			next = irand(random_seed, nVars());
+			if (value(next) == l_Undef && decision[next]) {
+				rnd_decisions++;
+				return mkLit(next, decisionPolarity(next));
+			}
+		}
+		next = vmtf_queue.next([&](Var v) {return value(v) != l_Undef || !decision[v];});
+		return next < 0 ? lit_Undef : mkLit(next, decisionPolarity(next));
+	}
+	
 	// Random decision:
 	if (drand(random_seed) < random_var_freq && !order_heap.empty()) {
 		next = order_heap[irand(random_seed, order_heap.size())];
@@ -445,7 +589,7 @@ Lit Solver::pickBranchLit() {
 		} else
 			next = order_heap.removeMin();
 
-	return next == var_Undef ? lit_Undef : mkLit(next, rnd_pol ? drand(random_seed) < 0.5 : polarity[next]);
+	return next == var_Undef ? lit_Undef : mkLit(next, decisionPolarity(next));
 }
 
 void Solver::instantiateLazyDecision(Lit p,int atLevel, CRef reason){
@@ -467,7 +611,7 @@ void Solver::instantiateLazyDecision(Lit p,int atLevel, CRef reason){
 	if (hasTheory(p)) {
 		int theoryID = getTheoryID(p);
 		needsPropagation(theoryID);
-		theories[theoryID]->enqueueTheory(getTheoryLit(p));
+		MONOSAT_THEORY_CALL(theoryID, enqueueTheory(getTheoryLit(p)));
 	}
 }
 
@@ -529,15 +673,27 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 		if (confl != CRef_Undef) {
 			assert(!isTheoryCause(confl));
 			Clause& c = ca[confl];
+			if (p != lit_Undef)
+				binaryReasonFirst(c, var(p));
 			
-			if (c.learnt())
+			if (c.learnt()) {
 				claBumpActivity(c);
+				if (c.tier() != LearntTier::CORE) {
+					c.setUsed(true);
+					unsigned lbd = computeLBD(c);
+					if (lbd < c.lbd())
+						setLearntLBD(c, lbd);
+				}
+			}
 			
 			for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++) {
 				Lit q = c[j];
 				if (!seen[var(q)] && level(var(q)) > 0) {
 					assert(value(q)==l_False);assert(var(q)!=var(theoryDecision));
-					varBumpActivity(var(q));
+					if (vmtf)
+						vmtf_bumped.push(var(q));
+					else
+						varBumpActivity(var(q));
 					seen[var(q)] = 1;
 					if(var(q)==10){
 						int a=1;
@@ -569,6 +725,8 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 				//lazily construct the reason for this theory propagation now that we need it
 				confl = constructReason(p);
 				//for some theories, we may discover while constructing the cause that p is at a lower level than we thought.
+			} else if (confl != CRef_Undef && hasTheory(p) && ca[confl].fromTheory()) {
+				stats_theory_reasons_reused++;
 			}
 			if(level(var(p))<decisionLevel()){
 				assert(value(p)==l_True);
@@ -601,6 +759,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 		}
 		assert(!seen.contains(1));
 		out_learnt.clear();
+		vmtf_bumped.clear();
 		analyze(original_confl,out_learnt,out_btlevel);
 		return;
 	}
@@ -631,6 +790,7 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 				out_learnt[j++] = out_learnt[i];
 			else {
 				Clause& c = ca[reason(var(out_learnt[i]))];
+				binaryReasonFirst(c, x);
 				for (int k = 1; k < c.size(); k++)
 					if (!seen[var(c[k])] && level(var(c[k])) > 0) {
 						out_learnt[j++] = out_learnt[i];
@@ -643,6 +803,10 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 	
 	max_literals += out_learnt.size();
 	out_learnt.shrink(i - j);
+	if (shrink)
+		shrinkClause(out_learnt, 1);
+	if (binary_min)
+		binaryMinimize(out_learnt);
 	tot_literals += out_learnt.size();
 	
 	// Find correct backtrack level:
@@ -673,6 +837,27 @@ void Solver::analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel) {
 #ifndef NDEBUG
 	assert(!seen.contains(1));
 #endif
+	if (vmtf)
+		vmtfBumpAnalyzed();
+}
+
+struct VMTFStampLt {
+	const VMTFQueue & queue;
+	VMTFStampLt(const VMTFQueue & queue) :
+			queue(queue) {
+	}
+	bool operator ()(Var x, Var y) const {
+		return queue.stamp(x) < queue.stamp(y);
+	}
+};
+
+// Move the variables bumped by 'analyze()' to the front of the decision queue,
+// preserving their relative order from before the conflict.
+void Solver::vmtfBumpAnalyzed() {
+	sort(vmtf_bumped, VMTFStampLt(vmtf_queue));
+	for (Var v : vmtf_bumped)
+		vmtf_queue.moveToFront(v);
+	vmtf_bumped.clear();
 }
 
 // Check if 'p' can be removed. 'abstract_levels' is used to abort early if the algorithm is
@@ -693,6 +878,7 @@ bool Solver::litRedundant(Lit p, uint32_t abstract_levels) {
 		}
 		
 		Clause& c = ca[reason(var(analyze_stack.last()))];
+		binaryReasonFirst(c, var(analyze_stack.last()));
 		analyze_stack.pop();
 		
 		for (int i = 1; i < c.size(); i++) {
@@ -715,6 +901,135 @@ bool Solver::litRedundant(Lit p, uint32_t abstract_levels) {
 	return true;
 }
 
+/*_________________________________________________________________________________________________
+ |
+ |  shrinkClause : (ps : vec<Lit>&) (first : int)  ->  [void]
+ |
+ |  Description:
+ |    All-UIP shrinking: replace the literals of each decision level in 'ps[first..]' (which must all be false, with
+ |    'seen' set for every literal of the clause and for every literal shown to be redundant by 'litRedundant()') by
+ |    the unique implication point of those literals at their level, if there is one that can be reached by resolving
+ |    only with reason clauses whose other literals are either at that level, or already seen.
+ |    The literals of 'ps[first..]' are reordered, by decreasing level.
+ |________________________________________________________________________________________________@*/
+void Solver::shrinkClause(vec<Lit>& ps, int first) {
+	if (ps.size() - first < 2)
+		return;
+	sort((Lit*) ps + first, ps.size() - first, LevelGt(*this));
+	int i, j;
+	for (i = j = first; i < ps.size();) {
+		int lev = level(var(ps[i]));
+		int end = i + 1;
+		while (end < ps.size() && level(var(ps[end])) == lev)
+			end++;
+		Lit uip = end - i > 1 ? shrinkLevel(ps, i, end, lev) : lit_Undef;
+		if (uip != lit_Undef) {
+			stats_shrunk_lits += end - i - 1;
+			ps[j++] = ~uip;
+			i = end;
+		} else {
+			while (i < end)
+				ps[j++] = ps[i++];
+		}
+	}
+	ps.shrink(i - j);
+}
+
+Lit Solver::shrinkLevel(const vec<Lit>& ps, int begin, int end, int lev) {
+	assert(lev > 0);
+	min_stamp++;
+	for (int k = begin; k < end; k++)
+		min_seen[var(ps[k])] = min_stamp;
+	int open = end - begin;
+	//Walk back over the trail of this level (literals that were lazily enqueued out of order are never reached, in which case this fails)
+	int bottom = trail_lim[lev - 1];
+	for (int i = (lev < decisionLevel() ? trail_lim[lev] : trail.size()) - 1; i >= bottom; i--) {
+		Var v = var(trail[i]);
+		if (min_seen[v] != min_stamp || level(v) != lev)
+			continue;
+		if (open == 1)
+			return trail[i];
+		CRef r = reason(v);
+		if (!ca.isClause(r))
+			return lit_Undef; //a decision, or a theory propagation whose reason has not been constructed
+		Clause& c = ca[r];
+		binaryReasonFirst(c, v);
+		for (int k = 1; k < c.size(); k++) {
+			Var u = var(c[k]);
+			if (level(u) == lev) {
+				if (min_seen[u] != min_stamp) {
+					min_seen[u] = min_stamp;
+					open++;
+				}
+			} else if (level(u) > 0 && !seen[u]) {
+				return lit_Undef;
+			}
+		}
+		open--;
+	}
+	return lit_Undef;
+}
+
+// Glucose-style minimization: if (out_learnt[0] | l) is a binary clause and '~l' is in 'out_learnt', then '~l' can be
+// resolved away.
+void Solver::binaryMinimize(vec<Lit>& out_learnt) {
+	if (out_learnt.size() <= 2)
+		return;
+	min_stamp++;
+	for (int i = 1; i < out_learnt.size(); i++)
+		min_seen[var(out_learnt[i])] = min_stamp;
+	int removed = 0;
+	const vec<Watcher>& ws = watches_bin.lookup(~out_learnt[0]);
+	for (int i = 0; i < ws.size(); i++) {
+		Lit imp = ws[i].blocker;
+		if (min_seen[var(imp)] == min_stamp && value(imp) == l_True) {
+			min_seen[var(imp)] = 0;
+			removed++;
+		}
+	}
+	if (removed == 0)
+		return;
+	int i, j;
+	for (i = j = 1; i < out_learnt.size(); i++)
+		if (min_seen[var(out_learnt[i])] == min_stamp)
+			out_learnt[j++] = out_learnt[i];
+	out_learnt.shrink(i - j);
+	stats_binary_min_lits += removed;
+}
+
+/*_________________________________________________________________________________________________
+ |
+ |  minimizeTheoryConflict : (ps : vec<Lit>&)  ->  [void]
+ |
+ |  Description:
+ |    Theory conflict clauses (such as the cuts found by the reachability and maximum flow detectors) are often
+ |    long, and are learnt as they are. Remove the literals that are redundant through reason clauses (as
+ |    -ccmin-mode=2 does for learnt clauses), and, with -shrink, shrink each level to its UIP.
+ |    Pre-condition: every literal of 'ps' is false, at a level above 0.
+ |________________________________________________________________________________________________@*/
+void Solver::minimizeTheoryConflict(vec<Lit>& ps) {
+	int size = ps.size();
+	analyze_toclear.clear();
+	uint32_t abstract_level = 0;
+	for (int i = 0; i < ps.size(); i++) {
+		seen[var(ps[i])] = 1;
+		analyze_toclear.push(ps[i]);
+		abstract_level |= abstractLevel(var(ps[i]));
+	}
+	int i, j;
+	if (ccmin_mode == 2) {
+		for (i = j = 0; i < ps.size(); i++)
+			if (!ca.isClause(reason(var(ps[i]))) || !litRedundant(ps[i], abstract_level))
+				ps[j++] = ps[i];
+		ps.shrink(i - j);
+	}
+	if (shrink)
+		shrinkClause(ps, 0);
+	for (i = 0; i < analyze_toclear.size(); i++)
+		seen[var(analyze_toclear[i])] = 0;
+	stats_theory_conflict_min_lits += size - ps.size();
+}
+
 /*_________________________________________________________________________________________________
  |
  |  analyzeFinal : (p : Lit)  ->  [void]
@@ -744,6 +1059,7 @@ void Solver::analyzeFinal(Lit p, vec<Lit>& out_conflict) {
 					constructReason(trail[i]);
 				}
 				Clause& c = ca[reason(x)];
+				binaryReasonFirst(c, x);
 				assert(var(c[0]) == x);
 				for (int j = 1; j < c.size(); j++)
 					if (level(var(c[j])) > 0)
@@ -770,7 +1086,7 @@ void Solver::enqueueLazy(Lit p, int lev, CRef from){
 		if (hasTheory(p)) {
 			int theoryID = getTheoryID(p);
 			needsPropagation(theoryID);
-			theories[theoryID]->enqueueTheory(getTheoryLit(p));
+			MONOSAT_THEORY_CALL(theoryID, enqueueTheory(getTheoryLit(p)));
 		}
 	}else if(value(p)==l_Undef){
 			uncheckedEnqueue(p, from);
@@ -787,7 +1103,7 @@ void Solver::uncheckedEnqueue(Lit p, CRef from) {
 	if (hasTheory(p)) {
 		int theoryID = getTheoryID(p);
 		needsPropagation(theoryID);
-		theories[theoryID]->enqueueTheory(getTheoryLit(p));
+		MONOSAT_THEORY_CALL(theoryID, enqueueTheory(getTheoryLit(p)));
 	}
 }
 
@@ -974,20 +1290,22 @@ CRef Solver::propagate(bool propagate_theories) {
 	CRef confl = CRef_Undef;
 	int num_props = 0;
 	watches.cleanAll();
+	watches_bin.cleanAll();
 	if (decisionLevel() == 0 && !propagate_theories) {
 		initialPropagate = true;//we will need to propagate this assignment to the theories at some point in the future.
 	}
 	do {
 		
 		while (qhead < trail.size()) {
-			if (opt_early_theory_prop) {
+			if (opt_early_theory_prop || theory_schedule) {
 				//propagate theories;
 				while (propagate_theories && theory_queue.size() && confl == CRef_Undef) {
-					theory_conflict.clear();
-					int theoryID = theory_queue.last();
-					theory_queue.pop();
-					in_theory_queue[theoryID] = false;
-					if (!theories[theoryID]->propagateTheory(theory_conflict)) {
+					int theoryID = nextTheory(true);
+					if (theoryID < 0)
+						break;
+					if (!runTheory(theoryID)) {
+						if (proof)
+							proofLemma(theory_conflict, theoryID);
 						if (!addConflictClause(theory_conflict, confl)) {
 							qhead = trail.size();
 							return confl;
@@ -997,10 +1315,33 @@ CRef Solver::propagate(bool propagate_theories) {
 			}
 			
 			Lit p = trail[qhead++];     // 'p' is enqueued fact to propagate.
+			num_props++;
+			//After chronological backtracking, 'p' may be assigned below the current decision level;
+			//then so are the literals it implies (see 'enqueueLazy()').
+			int p_level = level(var(p));
+			bool out_of_order = chrono_backtrack && p_level > 0 && p_level < decisionLevel();
+
+			// Propagate binary clauses first, without inspecting the clauses themselves:
+			vec<Watcher>& wbin = watches_bin[p];
+			for (int k = 0; k < wbin.size(); k++) {
+				Lit imp = wbin[k].blocker;
+				if (value(imp) == l_False) {
+					confl = wbin[k].cref;
+					break;
+				} else if (value(imp) == l_Undef) {
+					if (out_of_order)
+						enqueueLazy(imp, p_level, wbin[k].cref);
+					else
+						uncheckedEnqueue(imp, wbin[k].cref);
+				}
+			}
+			if (confl != CRef_Undef) {
+				qhead = trail.size();
+				break;
+			}
 
 			vec<Watcher>& ws = watches[p];
 			Watcher *i, *j, *end;
-			num_props++;
 			for (i = j = (Watcher*) ws, end = i + ws.size(); i != end;) {
 				// Try to avoid inspecting the clause:
 				Lit blocker = i->blocker;
@@ -1043,6 +1384,11 @@ CRef Solver::propagate(bool propagate_theories) {
 					// Copy the remaining watches:
 					while (i < end)
 						*j++ = *i++;
+				} else if (out_of_order) {
+					int lev = p_level;
+					for (int k = 2; k < c.size(); k++)
+						lev = std::max(lev, level(var(c[k])));
+					enqueueLazy(first, lev, cr);
 				} else
 					uncheckedEnqueue(first, cr);
 				
@@ -1058,7 +1404,7 @@ CRef Solver::propagate(bool propagate_theories) {
 				Lit p = trail[i];
 				if (hasTheory(p)) {
 					int theoryID = getTheoryID(p);
-					theories[theoryID]->enqueueTheory(getTheoryLit(p));
+					MONOSAT_THEORY_CALL(theoryID, enqueueTheory(getTheoryLit(p)));
 					
 				}
 			}
@@ -1078,13 +1424,14 @@ CRef Solver::propagate(bool propagate_theories) {
 		//propagate theories;
 		while (propagate_theories && theory_queue.size() && (opt_early_theory_prop || qhead == trail.size())
 				&& confl == CRef_Undef) {
-			theory_conflict.clear();
 			//todo: ensure that the bv theory comes first, as otherwise dependent theories may have to be propagated twice...
-			int theoryID = theory_queue.last();
-			theory_queue.pop();
-			in_theory_queue[theoryID] = false;
-			if (!theories[theoryID]->propagateTheory(theory_conflict)) {
+			int theoryID = nextTheory(qhead < trail.size());
+			if (theoryID < 0)
+				break;
+			if (!runTheory(theoryID)) {
 				bool has_conflict=true;
+				if (proof)
+					proofLemma(theory_conflict, theoryID);
 
 				if (has_conflict && !addConflictClause(theory_conflict, confl)) {
 
@@ -1113,13 +1460,67 @@ CRef Solver::propagate(bool propagate_theories) {
 	return confl;
 }
 
+//Without 'theory_schedule', theories are propagated last-in first-out.
+//Otherwise, pick the queued theory with the highest yield (conflicts or implied literals) per second of propagation time.
+//While literals are still waiting to be propagated, theories that are expensive on average are deferred.
+int Solver::nextTheory(bool literals_pending) {
+	int best = -1;
+	if (!theory_schedule) {
+		best = theory_queue.size() - 1;
+	} else {
+		double best_score = -1;
+		for (int i = 0; i < theory_queue.size(); i++) {
+			TheoryCost & c = theory_cost[theory_queue[i]];
+			if (literals_pending && c.time * 1e6 > opt_theory_early_cost) {
+				c.deferred++;
+				continue;
+			}
+			double score = (c.yield + 0.01) / (c.time + 1e-7);
+			if (score > best_score) {
+				best = i;
+				best_score = score;
+			}
+		}
+		if (best < 0)
+			return -1;
+	}
+	int theoryID = theory_queue[best];
+	theory_queue[best] = theory_queue.last();
+	theory_queue.pop();
+	in_theory_queue[theoryID] = false;
+	return theoryID;
+}
+
+bool Solver::runTheory(int theoryID) {
+	MONOSAT_PROFILE_SCOPE(theory_profile[theoryID], Propagate);
+	MONOSAT_TRACE_SPAN("propagateTheory", "theory", theoryID);
+	theory_conflict.clear();
+	int prev_source = proof_source;
+	proof_source = theoryID; //clauses the theory adds while propagating are theory lemmas
+	bool consistent;
+	if (!theory_schedule) {
+		consistent = MONOSAT_THEORY_CALL(theoryID, propagateTheory(theory_conflict));
+	} else {
+		int trail_size = trail.size();
+		auto start = std::chrono::steady_clock::now();
+		consistent = MONOSAT_THEORY_CALL(theoryID, propagateTheory(theory_conflict));
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		TheoryCost & c = theory_cost[theoryID];
+		c.time.update(elapsed.count());
+		c.yield.update(!consistent || trail.size() > trail_size);
+	}
+	proof_source = prev_source;
+	return consistent;
+}
+
 /*_________________________________________________________________________________________________
  |
  |  reduceDB : ()  ->  [void]
  |  
  |  Description:
- |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
- |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+ |    Remove half of the local tier of learnt clauses, minus the clauses locked by the current assignment.
+ |    Locked clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+ |    Core and tier2 clauses (see 'LearntTier') are not removed.
  |________________________________________________________________________________________________@*/
 struct reduceDB_lt {
 	ClauseAllocator& ca;
@@ -1140,22 +1541,72 @@ struct reduceDB_lt {
 	}
 	
 };
+template<class Lits>
+unsigned Solver::computeLBD(const Lits & lits) {
+	lbd_seen.growTo(decisionLevel() + 2, 0);
+	lbd_stamp++;
+	unsigned lbd = 0;
+	for (Lit l : lits) {
+		//unassigned literals (which can occur in theory clauses) are counted together, as one extra level
+		int lev = value(l) == l_Undef ? decisionLevel() + 1 : level(var(l));
+		if (lbd_seen[lev] != lbd_stamp) {
+			lbd_seen[lev] = lbd_stamp;
+			lbd++;
+		}
+	}
+	return lbd;
+}
+
+void Solver::setLearntLBD(Clause & c, unsigned lbd) {
+	assert(c.learnt());
+	c.setLBD(lbd);
+	LearntTier t = c.tier();
+	if (lbd <= (unsigned) opt_lbd_core && t != LearntTier::CORE) {
+		c.setTier(LearntTier::CORE);
+		n_core_learnts++;
+	} else if (lbd <= (unsigned) opt_lbd_tier2 && t == LearntTier::LOCAL) {
+		c.setTier(LearntTier::TIER2);
+	}
+}
+
 void Solver::reduceDB() {
+	MONOSAT_TRACE_SPAN("reduceDB", "solver");
 	int i, j;
-	double extra_lim = cla_inc / learnts.size();    // Remove any clause below this activity
-			
-	sort(learnts, reduceDB_lt(ca));
-	// Don't delete binary or locked clauses. From the rest, delete clauses from the first half
-	// and clauses with activity smaller than 'extra_lim':
+	// Core clauses are always kept. Tier2 clauses that were not used in conflict analysis since the last
+	// reduction are moved to the local tier. Only local clauses are deleted, by activity, as before:
+	reduce_tmp.clear();
+	n_core_learnts = 0;
 	for (i = j = 0; i < learnts.size(); i++) {
 		Clause& c = ca[learnts[i]];
-		if (c.size() > 2 && !locked(c) && (i < learnts.size() / 2 || c.activity() < extra_lim)) {
-			stats_removed_clauses++;
-			removeClause(learnts[i]);
-		} else
-			learnts[j++] = learnts[i];
+		if (c.tier() == LearntTier::LOCAL) {
+			reduce_tmp.push(learnts[i]);
+			continue;
+		} else if (c.tier() == LearntTier::CORE) {
+			n_core_learnts++;
+		} else if (!c.used()) {
+			c.setTier(LearntTier::LOCAL);
+		}
+		c.setUsed(false);
+		learnts[j++] = learnts[i];
 	}
 	learnts.shrink(i - j);
+
+	double extra_lim = cla_inc / reduce_tmp.size();    // Remove any clause below this activity
+	sort(reduce_tmp, reduceDB_lt(ca));
+	// Don't delete binary or locked clauses. From the rest, delete clauses from the first half
+	// and clauses with activity smaller than 'extra_lim':
+	for (i = 0; i < reduce_tmp.size(); i++) {
+		Clause& c = ca[reduce_tmp[i]];
+		if (c.size() > 2 && !locked(c) && (i < reduce_tmp.size() / 2 || c.activity() < extra_lim)) {
+			stats_removed_clauses++;
+			removeClause(reduce_tmp[i]);
+		} else {
+			c.setUsed(false);
+			learnts.push(reduce_tmp[i]);
+		}
+	}
+	if (generational_gc)
+		youngLast(learnts);
 	checkGarbage();
 }
 
@@ -1171,7 +1622,177 @@ void Solver::removeSatisfied(vec<CRef>& cs) {
 	cs.shrink(i - j);
 }
 
+/*_________________________________________________________________________________________________
+ |
+ |  inprocess : ()  ->  [bool]
+ |
+ |  Description:
+ |    Simplify the clause database between restarts: remove satisfied clauses, remove learnt clauses that are
+ |    subsumed by other clauses, and vivify the core and tier2 learnt clauses. No variables are eliminated, so
+ |    theory atoms are unaffected. Each round may take at most 'inprocess_time' of the time spent since the last one.
+ |    Returns false if the solver became unsatisfiable.
+ |________________________________________________________________________________________________@*/
+bool Solver::inprocess() {
+	MONOSAT_TRACE_SPAN("inprocess", "solver");
+	assert(decisionLevel() == 0);
+	auto start = std::chrono::steady_clock::now();
+	auto deadline = start
+			+ std::chrono::duration_cast<std::chrono::steady_clock::duration>((start - last_inprocess) * inprocess_time);
+	stats_inprocess_rounds++;
+	next_inprocess = conflicts + inprocess_interval;
+	bool consistent = ok && propagate(false) == CRef_Undef;
+	if (consistent) {
+		removeSatisfied(learnts);
+		if (remove_satisfied)
+			removeSatisfied(clauses);
+		subsumeLearnts(deadline);
+		consistent = vivifyLearnts(deadline);
+		checkGarbage();
+	}
+	auto end = std::chrono::steady_clock::now();
+	stats_inprocess_time += std::chrono::duration<double>(end - start).count();
+	last_inprocess = end;
+	return ok = consistent;
+}
+
+void Solver::subsumeLearnts(std::chrono::steady_clock::time_point deadline) {
+	learnt_occs.growTo(2 * nVars());
+	for (auto & occ : learnt_occs)
+		occ.clear();
+	for (CRef cr : learnts) {
+		Clause & c = ca[cr];
+		for (Lit l : c)
+			learnt_occs[toInt(l)].push(cr);
+	}
+	//Each clause (learnt or not) is checked against the learnt clauses that contain its least frequent literal.
+	//'seen' is used to mark the literals of the subsuming clause.
+	int checked = 0;
+	for (int pass = 0; pass < 2; pass++) {
+		vec<CRef> & cs = pass == 0 ? clauses : learnts;
+		for (int i = 0; i < cs.size(); i++) {
+			if ((++checked & 255) == 0 && std::chrono::steady_clock::now() > deadline)
+				goto done;
+			CRef cr = cs[i];
+			Clause & c = ca[cr];
+			if (c.mark())
+				continue;
+			Lit best = c[0];
+			for (Lit l : c) {
+				seen[var(l)] = 1 + sign(l);
+				if (learnt_occs[toInt(l)].size() < learnt_occs[toInt(best)].size())
+					best = l;
+			}
+			for (CRef dr : learnt_occs[toInt(best)]) {
+				Clause & d = ca[dr];
+				if (dr == cr || d.mark() || d.size() < c.size() || locked(d))
+					continue;
+				int found = 0;
+				for (Lit l : d) {
+					if (seen[var(l)] == 1 + sign(l))
+						found++;
+				}
+				if (found == c.size()) {
+					if (c.learnt() && d.tier() > c.tier())
+						c.setTier(d.tier());
+					stats_subsumed_learnts++;
+					removeClause(dr);
+				}
+			}
+			for (Lit l : c)
+				seen[var(l)] = 0;
+		}
+	}
+	done:
+	int i, j;
+	for (i = j = 0; i < learnts.size(); i++) {
+		if (!ca[learnts[i]].mark())
+			learnts[j++] = learnts[i];
+	}
+	learnts.shrink(i - j);
+}
+
+struct vivify_lt {
+	ClauseAllocator& ca;
+	vivify_lt(ClauseAllocator& ca_) :
+			ca(ca_) {
+	}
+	bool operator ()(CRef x, CRef y) {
+		return ca[x].lbd() < ca[y].lbd();
+	}
+};
+
+bool Solver::vivifyLearnts(std::chrono::steady_clock::time_point deadline) {
+	vivify_queue.clear();
+	for (CRef cr : learnts) {
+		Clause & c = ca[cr];
+		if (c.tier() != LearntTier::LOCAL && !c.vivified() && c.size() > 2 && !locked(c))
+			vivify_queue.push(cr);
+	}
+	sort(vivify_queue, vivify_lt(ca));
+	//Vivification makes temporary decisions, which must not overwrite the saved phases.
+	int saved_phase_saving = phase_saving;
+	phase_saving = 0;
+	bool consistent = true;
+	for (int n = 0; n < vivify_queue.size() && consistent; n++) {
+		if ((n & 15) == 0 && std::chrono::steady_clock::now() > deadline)
+			break;
+		CRef cr = vivify_queue[n];
+		Clause & c = ca[cr];
+		c.setVivified(true);
+		if (satisfied(c))
+			continue;
+		//Assign the negation of each literal in turn; if that implies a later literal of the clause, or a conflict,
+		//then the clause can be cut short. Literals that are implied false can be dropped.
+		detachClause(cr, true);
+		vivify_clause.clear();
+		for (Lit l : c) {
+			if (value(l) == l_False)
+				continue;
+			vivify_clause.push(l);
+			if (value(l) == l_True)
+				break;
+			newDecisionLevel();
+			uncheckedEnqueue(~l);
+			if (propagate(false) != CRef_Undef)
+				break;
+		}
+		cancelUntil(0);
+		if (vivify_clause.size() == c.size()) {
+			attachClause(cr);
+			continue;
+		}
+		stats_vivified_clauses++;
+		stats_vivified_lits += c.size() - vivify_clause.size();
+		if (proof) {
+			proof->add(vivify_clause);
+			proof->remove(c);
+		}
+		if (vivify_clause.size() <= 1) {
+			c.mark(1);
+			ca.free(cr);
+			consistent = vivify_clause.size() == 1 && enqueue(vivify_clause[0]) && propagate(false) == CRef_Undef;
+		} else {
+			for (int i = 0; i < vivify_clause.size(); i++)
+				c[i] = vivify_clause[i];
+			c.shrink(c.size() - vivify_clause.size());
+			if (c.lbd() > (unsigned) c.size())
+				setLearntLBD(c, c.size());
+			attachClause(cr);
+		}
+	}
+	phase_saving = saved_phase_saving;
+	int i, j;
+	for (i = j = 0; i < learnts.size(); i++) {
+		if (!ca[learnts[i]].mark())
+			learnts[j++] = learnts[i];
+	}
+	learnts.shrink(i - j);
+	return consistent;
+}
+
 void Solver::rebuildOrderHeap() {
+	if (vmtf)
+		return; //the decision queue doesn't need to be rebuilt; assigned variables are skipped lazily.
 	vec<Var> vs;
 	for (Var v = 0; v < nVars(); v++)
 		if (decision[v] && value(v) == l_Undef)
@@ -1188,6 +1809,7 @@ void Solver::rebuildOrderHeap() {
  |    thing done here is the removal of satisfied clauses, but more things can be put here.
  |________________________________________________________________________________________________@*/
 bool Solver::simplify() {
+	MONOSAT_TRACE_SPAN("simplify", "solver");
 	assert(decisionLevel() == 0);
 	
 	if (!ok || propagate() != CRef_Undef || !ok) //yes, the second ok check is now required, because propagation of a theory can make the solver unsat at this point...
@@ -1322,6 +1944,8 @@ void Solver::addClauseSafely(vec<Lit> & ps) {
 		//and IF that literal is already implied, then we may still need to adjust the level the literal should be implied at.
 		int undef_count=0;
 		int false_count=0;
+		if (proof)
+			proofClause(ps);
 		sort(ps);
 		Lit p;
 		int i, j;
@@ -1339,6 +1963,8 @@ void Solver::addClauseSafely(vec<Lit> & ps) {
 			}
 		}
 		ps.shrink(i - j);
+		if (proof && i != j)
+			proof->add(ps);
 		if(false_count==ps.size()-1){
 			//this clause is unit under the current assignment.
 			//although we _could_ wait until a restart to add this clause, in many cases this will lead to very poor solver behaviour.
@@ -1444,6 +2070,25 @@ bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent)
 
 	}
 	ps.shrink(i - j);
+	bool minimized = false;
+	if (theory_conflict_min && !permanent && decisionLevel() > 0 && ps.size() > 2) {
+		bool conflicting = true;
+		for (Lit l : ps) {
+			if (value(l) != l_False) {
+				conflicting = false;
+				break;
+			}
+		}
+		if (conflicting) {
+			int size = ps.size();
+			minimizeTheoryConflict(ps);
+			minimized = ps.size() < size;
+		}
+	}
+	if (proof && (i != j || minimized))
+		proof->add(ps);
+	if (exchange && !permanent)
+		exportClause(ps);
 /*	if(any_undef){
 		cancelUntil(0);//this is _not_ a conflict clause.
 	}*/
@@ -1453,6 +2098,8 @@ bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent)
 		cancelUntil(0);
 		return false;
 	} else if (ps.size() == 1) {
+		if (!permanent)
+			noteConflict(1, trail.size());
 		cancelUntil(0);
 
 		assert(var(ps[0]) < nVars());
@@ -1517,6 +2164,10 @@ bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent)
 				assert(value(ps[j])==l_False);
 		}
 #endif
+		//A theory conflict that is resolved here by backjumping never reaches the conflict handling in search(),
+		//so it has to be counted towards the dynamic restarts here (conflicting clauses are counted in search()).
+		if (!permanent && !satisfied && nfalse == ps.size() - 1)
+			noteConflict(computeLBD(ps), trail.size());
 		if (!permanent && ps.size() > opt_temporary_theory_conflicts) {
 			if (tmp_clause == CRef_Undef) {
 				tmp_clause = ca.alloc(ps, false);
@@ -1542,6 +2193,10 @@ bool Solver::addConflictClause(vec<Lit> & ps, CRef & confl_out, bool permanent)
 			
 			CRef cr = ca.alloc(ps, !permanent && !opt_permanent_theory_conflicts);
 			ca[cr].setFromTheory(true);
+			if (ca[cr].learnt())
+				setLearntLBD(ca[cr], computeLBD(ps));
+			else
+				ca[cr].setLBD(computeLBD(ps));
 			if (permanent || opt_permanent_theory_conflicts)
 				clauses.push(cr);
 			else {
@@ -1609,13 +2264,15 @@ bool Solver::addDelayedClauses(CRef & conflict_out) {
  |    if the clause set is unsatisfiable. 'l_Undef' if the bound on number of conflicts is reached.
  |________________________________________________________________________________________________@*/
 lbool Solver::search(int nof_conflicts) {
+	MONOSAT_TRACE_SPAN("search", "solver", starts);
 	assert(ok);
 	int backtrack_level;
 	int conflictC = 0;
 	vec<Lit> learnt_clause;
 	bool last_decision_was_theory=false;
 	starts++;
-	bool using_theory_decisions= opt_decide_theories && drand(random_seed) < opt_random_theory_freq;
+	restart_conflicts = 0;
+	bool using_theory_decisions= opt_decide_theories && decide_theories && drand(random_seed) < opt_random_theory_freq;
 	n_theory_decision_rounds+=using_theory_decisions;
 	//last_dec = var_Undef;
 	for (;;) {
@@ -1627,6 +2284,7 @@ lbool Solver::search(int nof_conflicts) {
 		conflict: if (!okay() || (confl != CRef_Undef)) {
 			// CONFLICT
 			conflicts++;
+			MONOSAT_PROFILE_POLL();
 			conflictC++;
 			if(last_decision_was_theory){
 				n_theory_conflicts++;
@@ -1640,10 +2298,27 @@ lbool Solver::search(int nof_conflicts) {
 			}
 			if (decisionLevel() == 0)
 				return l_False;
+			if (target_phases || rephase_interval > 0)
+				updatePhases();
 			learnt_clause.clear();
 			analyze(confl, learnt_clause, backtrack_level);
+			if (proof)
+				proof->add(learnt_clause);
+			unsigned lbd = computeLBD(learnt_clause);
+			noteConflict(lbd, trail.size());
 			
-			cancelUntil(backtrack_level);
+			//analyze() has backtracked to the level of the conflict. If backjumping from there would undo
+			//many levels, backtrack just one, and assign the asserting literal out of order at 'backtrack_level' instead.
+			int conflict_level = decisionLevel();
+			if (chrono_backtrack && learnt_clause.size() > 1 && conflict_level - backtrack_level > opt_chrono_backtrack) {
+				stats_chrono_backtracks++;
+				cancelUntil(conflict_level - 1);
+			} else
+				cancelUntil(backtrack_level);
+			if (phase_hints_pending)
+				addTheoryPhaseHints();
+			if (exchange)
+				exportClause(learnt_clause);
 			
 			//this is now slightly more complicated, if there are multiple lits implied by the super solver in the current decision level:
 			//The learnt clause may not be asserting.
@@ -1655,9 +2330,10 @@ lbool Solver::search(int nof_conflicts) {
 				learnts.push(cr);
 				attachClause(cr);
 				claBumpActivity(ca[cr]);
+				setLearntLBD(ca[cr], lbd);
 				
 				if (value(learnt_clause[0]) == l_Undef) {
-					uncheckedEnqueue(learnt_clause[0], cr);
+					enqueueLazy(learnt_clause[0], backtrack_level, cr);
 				} else {
 
 					assert(S);
@@ -1707,7 +2383,7 @@ lbool Solver::search(int nof_conflicts) {
 			}
 			
 			// NO CONFLICT
-			if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget()) {
+			if (restartDue(nof_conflicts, conflictC) || !withinBudget()) {
 				// Reached bound on number of conflicts:
 				progress_estimate = progressEstimate();
 				cancelUntil(initial_level);
@@ -1718,7 +2394,7 @@ lbool Solver::search(int nof_conflicts) {
 			if (decisionLevel() == 0 && !simplify())
 				return l_False;
 			
-			if (learnts.size() - nAssigns() >= max_learnts)
+			if (learnts.size() - n_core_learnts - nAssigns() >= max_learnts)
 				// Reduce the set of learnt clauses:
 				reduceDB();
 			last_decision_was_theory=false;
@@ -1741,13 +2417,16 @@ lbool Solver::search(int nof_conflicts) {
 			//Note: decision level is now added before theories make their decisions, to allow them to decide multiple literals at once.
 			newDecisionLevel();
 
-			if (opt_decide_theories && using_theory_decisions && next == lit_Undef && (opt_theory_conflict_max==0 || conflicts>=next_theory_decision) ) {
+			if (using_theory_decisions && next == lit_Undef && (opt_theory_conflict_max==0 || conflicts>=next_theory_decision) ) {
 				/**
 				 * Give the theory solvers a chance to make decisions
 				 */
 				for (int i = 0; i < decidable_theories.size() && next == lit_Undef; i++) {
-					
-					next = decidable_theories[i]->decideTheory();
+					{
+						int theoryID = decidable_theories[i]->getTheoryIndex();
+						MONOSAT_PROFILE_SCOPE(theory_profile[theoryID], Decide);
+						next = MONOSAT_THEORY_CALL(theoryID, decideTheory());
+					}
 					if(theoryDecision !=lit_Undef && var(next)==var(theoryDecision)){
 						assigns[var(theoryDecision)]=l_Undef;
 					}
@@ -1772,7 +2451,17 @@ lbool Solver::search(int nof_conflicts) {
 						if (opt_subsearch == 3 && track_min_level < initial_level)
 							continue; //Disable attempting to solve sub-solvers if we've backtracked past the super solver's decision level
 							
-						if (!theories[i]->solveTheory(theory_conflict)) {
+						bool solved;
+						{
+							MONOSAT_PROFILE_SCOPE(theory_profile[i], Solve);
+							int prev_source = proof_source;
+							proof_source = i;
+							solved = theories[i]->solveTheory(theory_conflict);
+							proof_source = prev_source;
+						}
+						if (!solved) {
+							if (proof)
+								proofLemma(theory_conflict, i);
 							if (!addConflictClause(theory_conflict, confl)) {
 								goto conflict;
 							} else {
@@ -1800,6 +2489,98 @@ lbool Solver::search(int nof_conflicts) {
 	return l_Undef;
 }
 
+void Solver::noteConflict(unsigned lbd, int trail_size) {
+	restart_conflicts++;
+	lbd_ema_fast.update(lbd);
+	lbd_ema_slow.update(lbd);
+	//Glucose style restart blocking: if the trail is much larger than usual, the solver may be
+	//close to a satisfying assignment, so postpone the next restart.
+	if (ema_restart && opt_restart_block > 0 && conflicts > (uint64_t) opt_restart_block_start
+			&& restart_conflicts >= (uint64_t) opt_restart_min && trail_size > opt_restart_block * trail_ema) {
+		restart_conflicts = 0;
+		stats_blocked_restarts++;
+	}
+	trail_ema.update(trail_size);
+}
+
+bool Solver::restartDue(int nof_conflicts, int conflictC) const {
+	if (!ema_restart)
+		return nof_conflicts >= 0 && conflictC >= nof_conflicts;
+	//Dynamic restarts ignore the conflict limit; restart once the recent conflicts are
+	//noticeably worse (have higher LBD) than the long term average.
+	return restart_conflicts >= (uint64_t) opt_restart_min && lbd_ema_fast > opt_restart_margin * lbd_ema_slow;
+}
+
+void Solver::updatePhases() {
+	//Everything below the conflict level was propagated without a conflict.
+	int n = trail_lim.last();
+	if (n > target_assigned) {
+		for (int i = 0; i < n; i++)
+			target_phase[var(trail[i])] = sign(trail[i]);
+		target_assigned = n;
+	}
+	if (n > best_assigned) {
+		best_generation++;
+		for (int i = 0; i < n; i++) {
+			best_phase[var(trail[i])] = sign(trail[i]);
+			best_stamp[var(trail[i])] = best_generation;
+		}
+		best_assigned = n;
+		//(the theories still hold the conflicting level here, so they are asked for hints after backtracking from it)
+		phase_hints_pending = opt_theory_phase_hints && theories.size();
+	}
+}
+
+void Solver::addTheoryPhaseHints() {
+	//The trail is now a conflict-free prefix of the one 'best_phase' was recorded from, and the theories are in sync with it.
+	//Let them extend the recorded assignment, e.g. with the edges of a path to a node that must be reachable,
+	//without overriding the variables it assigned.
+	phase_hints_pending = false;
+	for (Theory * t : theories) {
+		phase_hints.clear();
+		t->addPhaseHints(phase_hints);
+		for (Lit l : phase_hints) {
+			if (value(l) == l_Undef && best_stamp[var(l)] != best_generation) {
+				target_phase[var(l)] = sign(l);
+				best_phase[var(l)] = sign(l);
+				stats_phase_hints++;
+			}
+		}
+	}
+}
+
+void Solver::rephase() {
+	enum {
+		ORIGINAL, INVERTED, BEST, RANDOM
+	};
+	static const int schedule[] = { ORIGINAL, BEST, INVERTED, BEST, RANDOM, BEST };
+	int kind = schedule[n_rephases % (sizeof(schedule) / sizeof(schedule[0]))];
+	n_rephases++;
+	stats_rephases++;
+	for (Var v = 0; v < nVars(); v++) {
+		switch (kind) {
+			case ORIGINAL:
+				polarity[v] = original_phase[v];
+				break;
+			case INVERTED:
+				polarity[v] = !original_phase[v];
+				break;
+			case BEST:
+				if (best_phase[v] != 2)
+					polarity[v] = best_phase[v];
+				break;
+			default:
+				polarity[v] = drand(random_seed) < 0.5;
+				break;
+		}
+		target_phase[v] = 2;
+	}
+	target_assigned = 0;
+	if (kind == BEST)
+		best_assigned = 0;
+	next_rephase = conflicts + (uint64_t) rephase_interval * (n_rephases + 1);
+}
+
 double Solver::progressEstimate() const {
 	double progress = 0;
 	double F = 1.0 / nVars();
@@ -1842,9 +2623,396 @@ static double luby(double y, int x) {
 	return pow(y, seq);
 }
 
+/*_________________________________________________________________________________________________
+ |
+ |  cube : (assumps : const vec<Lit>&) (depth : int) (n_candidates : int) (out_cubes : vec<vec<Lit>>&)  ->  [bool]
+ |
+ |  Description:
+ |    Split the search space for cube-and-conquer: the problem is satisfiable under 'assumps' if and only if one of
+ |    the cubes (conjunctions of literals, beginning with 'assumps', to be solved as assumptions) is satisfiable.
+ |    Splits are chosen by lookahead over the 'n_candidates' theory atoms that occur most often in the clauses.
+ |    Each polarity of a candidate is propagated (through the theories), and the candidate that assigns the most
+ |    theory atoms in both polarities is chosen (for a graph, each assigned edge atom removes an edge from the
+ |    over-approximate graph, or adds one to the under-approximate graph). Candidates that fail in one polarity are
+ |    assigned the other, and branches that fail are dropped.
+ |________________________________________________________________________________________________@*/
+bool Solver::cube(const vec<Lit> & assumps, int depth, int n_candidates, vec<vec<Lit>> & out_cubes) {
+	out_cubes.clear();
+	cancelUntil(0);
+	if (!ok || propagate() != CRef_Undef)
+		return ok = false;
+	vec<int> occurrences;
+	occurrences.growTo(nVars(), 0);
+	for (CRef cr : clauses) {
+		for (Lit l : ca[cr])
+			occurrences[var(l)]++;
+	}
+	vec<Var> candidates;
+	for (Var v = 0; v < nVars(); v++) {
+		if (hasTheory(v) && decision[v] && value(v) == l_Undef)
+			candidates.push(v);
+	}
+	std::stable_sort((Var*) candidates, ((Var*) candidates) + candidates.size(),
+			[&](Var a, Var b) {return occurrences[a] > occurrences[b];});
+	if (candidates.size() > n_candidates)
+		candidates.shrink(candidates.size() - n_candidates);
+	vec<Lit> prefix;
+	assumps.copyTo(prefix);
+	splitCube(prefix, depth, candidates, out_cubes);
+	cancelUntil(0);
+	return out_cubes.size() > 0;
+}
+
+bool Solver::assertCube(const vec<Lit> & cube) {
+	cancelUntil(0);
+	if (propagate() != CRef_Undef)
+		return ok = false;
+	for (Lit l : cube) {
+		int lev = decisionLevel();
+		newDecisionLevel();
+		if (value(l) == l_False)
+			return false;
+		if (value(l) == l_Undef) {
+			uncheckedEnqueue(l);
+			if (propagate() != CRef_Undef)
+				return false;
+		}
+		if (decisionLevel() != lev + 1)
+			return ok && assertCube(cube); //a theory conflict clause backjumped past the cube; start over (with the new clause)
+	}
+	return true;
+}
+
+int Solver::lookahead(Lit l) {
+	stats_lookaheads++;
+	int lev = decisionLevel();
+	int start = trail.size();
+	newDecisionLevel();
+	uncheckedEnqueue(l);
+	int score = -1;
+	if (propagate() == CRef_Undef) {
+		score = 0;
+		for (int i = start; i < trail.size(); i++) {
+			if (hasTheory(trail[i]))
+				score++;
+		}
+	}
+	if (decisionLevel() != lev + 1)
+		score = -2;
+	cancelUntil(lev);
+	return score;
+}
+
+void Solver::splitCube(vec<Lit> & prefix, int depth, const vec<Var> & candidates, vec<vec<Lit>> & out_cubes) {
+	if (!assertCube(prefix))
+		return;
+	Var best = var_Undef;
+	if (depth > 0) {
+		double best_score = -1;
+		for (Var v : candidates) {
+			if (value(v) != l_Undef)
+				continue;
+			int pos = lookahead(mkLit(v));
+			int neg = pos == -2 ? -2 : lookahead(mkLit(v, true));
+			if (pos == -2 || neg == -2) {
+				if (!assertCube(prefix))
+					return;
+				continue;
+			}
+			if (pos < 0 || neg < 0) {
+				//failed literal: the other polarity is implied by the prefix
+				stats_failed_literals++;
+				if (pos < 0 && neg < 0)
+					return;
+				uncheckedEnqueue(mkLit(v, pos < 0));
+				if (propagate() != CRef_Undef)
+					return;
+				if (decisionLevel() != prefix.size() && !assertCube(prefix))
+					return;
+				continue;
+			}
+			double score = (pos + 1.0) * (neg + 1.0);
+			if (score > best_score) {
+				best_score = score;
+				best = v;
+			}
+		}
+	}
+	if (best == var_Undef) {
+		out_cubes.push();
+		prefix.copyTo(out_cubes.last());
+		return;
+	}
+	for (int polarity = 0; polarity < 2; polarity++) {
+		prefix.push(mkLit(best, polarity));
+		splitCube(prefix, depth - 1, candidates, out_cubes);
+		prefix.pop();
+	}
+}
+
+uint64_t Solver::snapshotLayout() {
+	//FNV-1a
+	uint64_t h = 14695981039346656037ULL;
+	auto mix = [&](uint64_t x) {
+		h = (h ^ x) * 1099511628211ULL;
+	};
+	mix(input_fingerprint);
+	mix(nVars());
+	mix(theories.size());
+	for (Var v = 0; v < nVars(); v++) {
+		if (hasTheory(v)) {
+			mix(getTheoryID(v) + 1);
+			mix(getTheoryVar(v));
+		} else {
+			mix(0);
+		}
+	}
+	return h;
+}
+
+/*_________________________________________________________________________________________________
+ |
+ |  writeSnapshot : (file : const char*)  ->  [bool]
+ |
+ |  Description:
+ |    Write the search state to 'file' (see 'SnapshotHeader'), so that a new process can resume the search with
+ |    'loadSnapshot()'. The snapshot is written to a temporary file, which then replaces 'file', so that
+ |    an interrupted write never leaves a truncated snapshot behind.
+ |________________________________________________________________________________________________@*/
+bool Solver::writeSnapshot(const char * file) {
+	MONOSAT_TRACE_SPAN("snapshot", "solver");
+	auto start = std::chrono::steady_clock::now();
+	std::string tmp = std::string(file) + ".tmp";
+	FILE * f = fopen(tmp.c_str(), "wb");
+	if (!f)
+		return false;
+	vec<Lit> units;
+	for (Lit l : trail) {
+		if (level(var(l)) == 0)
+			units.push(l);
+	}
+	SnapshotHeader h;
+	memset(&h, 0, sizeof(h));
+	h.magic = SnapshotHeader::Magic;
+	h.header_size = sizeof(SnapshotHeader);
+	h.clause_header_size = sizeof(Clause);
+	h.n_vars = nVars();
+	h.n_theories = theories.size();
+	h.layout = snapshotLayout();
+	h.n_units = units.size();
+	h.n_learnts = learnts.size();
+	for (CRef cr : learnts)
+		h.n_learnt_words += ClauseAllocator::clauseWords(ca[cr]);
+	h.conflicts = conflicts;
+	h.decisions = decisions;
+	h.propagations = propagations;
+	h.starts = starts;
+	h.next_rephase = next_rephase;
+	h.next_inprocess = next_inprocess;
+	h.var_inc = var_inc;
+	h.cla_inc = cla_inc;
+	h.target_assigned = target_assigned;
+	h.best_assigned = best_assigned;
+
+	static const char zeros[8] = { };
+	auto section = [&](const void * data, size_t bytes) {
+		fwrite(data, 1, bytes, f);
+		fwrite(zeros, 1, snapshotPadding(bytes), f);
+	};
+	section(&h, sizeof(h));
+	section((const double*) activity, sizeof(double) * nVars());
+	section((const char*) polarity, nVars());
+	section((const char*) target_phase, nVars());
+	section((const char*) best_phase, nVars());
+	section((const Lit*) units, sizeof(Lit) * units.size());
+	for (CRef cr : learnts)
+		fwrite(ca.lea(cr), sizeof(uint32_t), ClauseAllocator::clauseWords(ca[cr]), f);
+	fwrite(zeros, 1, snapshotPadding(h.n_learnt_words * sizeof(uint32_t)), f);
+
+	bool written = !ferror(f) && fflush(f) == 0 && fsync(fileno(f)) == 0;
+	written = fclose(f) == 0 && written;
+	if (!written || rename(tmp.c_str(), file) != 0) {
+		::remove(tmp.c_str());
+		return false;
+	}
+	stats_snapshots++;
+	stats_snapshot_time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return true;
+}
+
+/*_________________________________________________________________________________________________
+ |
+ |  loadSnapshot : (file : const char*)  ->  [bool]
+ |
+ |  Description:
+ |    Restore the search state from a snapshot written by 'writeSnapshot()'. The solver must have been built
+ |    from the same input, with the same options (so that every variable, and theory atom, has the same meaning
+ |    as in the solver that wrote the snapshot); this is checked, and false is returned if the snapshot does not match.
+ |    The snapshot is memory mapped; the learnt clauses are copied from it directly into the clause allocator.
+ |________________________________________________________________________________________________@*/
+bool Solver::loadSnapshot(const char * file) {
+	MONOSAT_TRACE_SPAN("restore snapshot", "solver");
+	MappedFile mapped;
+	if (!mapped.open(file) || mapped.size() < sizeof(SnapshotHeader))
+		return false;
+	const char * p = mapped.bytes();
+	const char * end = p + mapped.size();
+	SnapshotHeader h;
+	memcpy(&h, p, sizeof(h));
+	if (h.magic != SnapshotHeader::Magic || h.header_size != sizeof(SnapshotHeader)
+			|| h.clause_header_size != sizeof(Clause) || h.n_vars != nVars() || h.n_theories != theories.size()
+			|| h.layout != snapshotLayout())
+		return false;
+	//(the counts are checked against the file size first, so that the section sizes cannot overflow)
+	if (h.n_units > (uint64_t) nVars() || h.n_learnt_words > mapped.size() || h.n_learnts > h.n_learnt_words) {
+		fprintf(stderr, "Snapshot %s is corrupt\n", file);
+		return false;
+	}
+	auto section = [&](uint64_t bytes) -> const char* {
+		uint64_t padded = bytes + snapshotPadding(bytes);
+		if (!p || padded > (uint64_t) (end - p))
+			return p = nullptr;
+		const char * s = p;
+		p += padded;
+		return s;
+	};
+	p += sizeof(h) + snapshotPadding(sizeof(h));
+	const double * activities = (const double*) section(sizeof(double) * nVars());
+	const char * polarities = section(nVars());
+	const char * target_phases = section(nVars());
+	const char * best_phases = section(nVars());
+	const Lit * unit_lits = (const Lit*) section(sizeof(Lit) * h.n_units);
+	const uint32_t * learnt_words = (const uint32_t*) section(sizeof(uint32_t) * h.n_learnt_words);
+	if (!learnt_words) {
+		fprintf(stderr, "Snapshot %s is truncated\n", file);
+		return false;
+	}
+
+	//Check every literal, and the extent of every clause, before changing anything.
+	auto validLit = [&](Lit l) {
+		return l.x >= 0 && var(l) < nVars();
+	};
+	for (uint64_t i = 0; i < h.n_units; i++) {
+		if (!validLit(unit_lits[i])) {
+			fprintf(stderr, "Snapshot %s is corrupt: bad unit literal\n", file);
+			return false;
+		}
+	}
+	const uint64_t clause_header_words = sizeof(Clause) / sizeof(uint32_t);
+	uint64_t pos = 0;
+	for (uint64_t i = 0; i < h.n_learnts; i++) {
+		bool valid = h.n_learnt_words - pos >= clause_header_words;
+		if (valid) {
+			const Clause & c = *(const Clause*) (learnt_words + pos);
+			uint64_t words = ClauseAllocator::clauseWords(c);
+			valid = words >= clause_header_words && h.n_learnt_words - pos >= words;
+			for (int j = 0; valid && j < c.size(); j++)
+				valid = validLit(c[j]);
+			pos += words;
+		}
+		if (!valid) {
+			fprintf(stderr, "Snapshot %s is corrupt: bad learnt clause %" PRIu64 "\n", file, i);
+			return false;
+		}
+	}
+	if (pos != h.n_learnt_words) {
+		fprintf(stderr, "Snapshot %s is corrupt: %" PRIu64 " unused learnt clause words\n", file, h.n_learnt_words - pos);
+		return false;
+	}
+
+	cancelUntil(0);
+	if (!ok)
+		return false;
+	conflicts = h.conflicts;
+	decisions = h.decisions;
+	propagations = h.propagations;
+	starts = h.starts;
+	next_rephase = h.next_rephase;
+	next_inprocess = h.next_inprocess;
+	var_inc = h.var_inc;
+	cla_inc = h.cla_inc;
+	target_assigned = h.target_assigned;
+	best_assigned = h.best_assigned;
+	for (Var v = 0; v < nVars(); v++) {
+		activity[v] = activities[v];
+		polarity[v] = polarities[v];
+		target_phase[v] = target_phases[v];
+		best_phase[v] = best_phases[v];
+	}
+	rebuildOrderHeap();
+
+	//Everything below was derived from the input (and the theories) by the solver that wrote the snapshot.
+	//Proofs can't derive it again, so it is logged as input.
+	vec<Lit> unit(1);
+	for (uint64_t i = 0; i < h.n_units && ok; i++) {
+		unit[0] = unit_lits[i];
+		if (proof)
+			proof->input(unit);
+		if (value(unit[0]) == l_False)
+			ok = false;
+		else if (value(unit[0]) == l_Undef)
+			uncheckedEnqueue(unit[0]);
+	}
+	if (!ok || propagate() != CRef_Undef) {
+		ok = false;
+		return true;
+	}
+
+	vec<Lit> lits;
+	pos = 0;
+	for (uint64_t i = 0; i < h.n_learnts && ok; i++) {
+		const Clause & c = *(const Clause*) (learnt_words + pos);
+		pos += ClauseAllocator::clauseWords(c);
+		if (proof)
+			proof->input(c);
+		//drop clauses that are satisfied, and literals that are falsified, at level 0
+		lits.clear();
+		bool satisfied = false;
+		for (Lit l : c) {
+			if (value(l) == l_True) {
+				satisfied = true;
+				break;
+			} else if (value(l) == l_Undef) {
+				lits.push(l);
+			}
+		}
+		if (satisfied)
+			continue;
+		if (lits.size() == 0) {
+			ok = false;
+		} else if (lits.size() == 1) {
+			uncheckedEnqueue(lits[0]);
+		} else {
+			CRef cr = ca.alloc(lits, true);
+			Clause & d = ca[cr];
+			d.setFromTheory(c.fromTheory());
+			d.setLBD(c.lbd());
+			d.setTier(c.tier());
+			d.setVivified(c.vivified() && lits.size() == c.size());
+			d.activity() = c.activity();
+			learnts.push(cr);
+			attachClause(cr);
+		}
+	}
+	if (ok && propagate() != CRef_Undef)
+		ok = false;
+	return true;
+}
+
+void Solver::setCheckpoint(const char * file, double interval_seconds) {
+	checkpoint_file = file;
+	checkpoint_interval = interval_seconds;
+	next_checkpoint = std::chrono::steady_clock::now()
+			+ std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+					std::chrono::duration<double>(interval_seconds));
+}
+
 // NOTE: assumptions passed in member-variable 'assumptions'.
 lbool Solver::solve_() {
-	cancelUntil(0);
+	MONOSAT_TRACE_SPAN("solve", "solver", solves);
+	int reuse_level = reusableTrailLevel();
+	stats_reused_levels += reuse_level;
+	cancelUntil(reuse_level);
 	model.clear();
 	conflict.clear();
 	if (!ok)
@@ -1867,6 +3035,15 @@ lbool Solver::solve_() {
 	}
 	initial_level = 0;
 	track_min_level = 0;
+	chrono_backtrack = opt_chrono_backtrack >= 0 && !S;
+	for (Theory * t : theories) {
+		if (!t->supportsChronologicalBacktracking())
+			chrono_backtrack = false;
+	}
+	if (rephase_interval > 0 && next_rephase == 0)
+		next_rephase = conflicts + rephase_interval;
+	if (inprocess_interval > 0 && next_inprocess == 0)
+		next_inprocess = conflicts + inprocess_interval;
 	// Search:
 	int curr_restarts = 0;
 	while (status == l_Undef) {
@@ -1881,6 +3058,28 @@ lbool Solver::solve_() {
 		if (!withinBudget())
 			break;
 		curr_restarts++;
+		target_assigned = 0;
+		if (rephase_interval > 0 && status == l_Undef && conflicts >= next_rephase)
+			rephase();
+		if (inprocess_interval > 0 && status == l_Undef && conflicts >= next_inprocess && decisionLevel() == 0
+				&& !inprocess())
+			status = l_False;
+		if (exchange && status == l_Undef && !importClauses())
+			status = l_False;
+		if (checkpoint_file.size() && status == l_Undef
+				&& (checkpoint_requested
+						|| (checkpoint_interval > 0 && std::chrono::steady_clock::now() >= next_checkpoint))) {
+			checkpoint_requested = false;
+			if (!writeSnapshot(checkpoint_file.c_str()))
+				fprintf(stderr, "Could not write snapshot to %s\n", checkpoint_file.c_str());
+			if (checkpoint_interval > 0)
+				setCheckpoint(checkpoint_file.c_str(), checkpoint_interval);
+			if (checkpoint_stop) {
+				checkpoint_stop = false;
+				interrupt();
+				break;
+			}
+		}
 		if (opt_rnd_restart && status == l_Undef) {
 			
 			for (int i = 0; i < nVars(); i++) {
@@ -1920,10 +3119,83 @@ lbool Solver::solve_() {
 		assert(ok);
 	}
 	
+	//Record which assumptions the remaining decision levels were made for, so that the next solve can keep them.
+	assumptions.copyTo(trail_assumptions);
+	if (trail_assumptions.size() > decisionLevel())
+		trail_assumptions.shrink(trail_assumptions.size() - decisionLevel());
 	assumptions.clear();
 	return status;
 }
 
+int Solver::reusableTrailLevel() const {
+	if (!opt_reuse_trail || S)
+		return 0;
+	//Level i+1 was made for assumption i (see search()), so the levels of a common prefix of assumptions are still valid.
+	int lev = 0;
+	while (lev < trail_assumptions.size() && lev < assumptions.size() && lev < decisionLevel()
+			&& trail_assumptions[lev] == assumptions[lev])
+		lev++;
+	return lev;
+}
+
+void Solver::setClauseExchange(ClauseExchange * exchange, int exchange_id, const vec<bool> & shareable) {
+	this->exchange = exchange;
+	this->exchange_id = exchange_id;
+	shareable.copyTo(this->shareable);
+	import_cursors.clear();
+	import_cursors.growTo(exchange ? exchange->nSolvers() : 0, 0);
+}
+
+void Solver::exportClause(const vec<Lit> & clause) {
+	if (clause.size() == 0 || clause.size() > opt_portfolio_share_size)
+		return;
+	for (Lit l : clause) {
+		if (var(l) >= shareable.size() || !shareable[var(l)])
+			return;
+	}
+	if (exchange->publish(exchange_id, clause))
+		stats_shared_exported++;
+}
+
+bool Solver::importClauses() {
+	assert(decisionLevel() == 0);
+	for (int p = 0; p < exchange->nSolvers() && ok; p++) {
+		if (p == exchange_id)
+			continue;
+		while (ok && exchange->fetch(p, import_cursors[p], import_tmp)) {
+			//drop clauses that are already satisfied, and literals that are already falsified, at level 0
+			bool skip = false;
+			int i, j;
+			for (i = j = 0; i < import_tmp.size(); i++) {
+				Lit l = import_tmp[i];
+				if (var(l) >= shareable.size() || !shareable[var(l)] || value(l) == l_True) {
+					skip = true;
+					break;
+				} else if (value(l) == l_Undef) {
+					import_tmp[j++] = l;
+				}
+			}
+			if (skip)
+				continue;
+			import_tmp.shrink(i - j);
+			stats_shared_imported++;
+			if (import_tmp.size() == 0) {
+				ok = false;
+			} else if (import_tmp.size() == 1) {
+				uncheckedEnqueue(import_tmp[0]);
+			} else {
+				CRef cr = ca.alloc(import_tmp, true);
+				learnts.push(cr);
+				attachClause(cr);
+				claBumpActivity(ca[cr]);
+				//all of its literals are unassigned at level 0, so use the size of the clause as its LBD
+				setLearntLBD(ca[cr], import_tmp.size());
+			}
+		}
+	}
+	return ok;
+}
+
 bool Solver::solveTheory(vec<Lit> & conflict_out) {
 	initial_level = decisionLevel();
 	track_min_level = initial_level;
@@ -2062,6 +3334,9 @@ void Solver::relocAll(ClauseAllocator& to) {
 	//
 	// for (int i = 0; i < watches.size(); i++)
 	watches.cleanAll();
+	watches_bin.cleanAll();
+	young_smudged.clear();
+	young_smudged_bin.clear();
 	for (int v = 0; v < nVars(); v++){
 
 		for (int s = 0; s < 2; s++) {
@@ -2070,6 +3345,9 @@ void Solver::relocAll(ClauseAllocator& to) {
 			vec<Watcher>& ws = watches[p];
 			for (int j = 0; j < ws.size(); j++)
 				ca.reloc(ws[j].cref, to);
+			vec<Watcher>& wbin = watches_bin[p];
+			for (int j = 0; j < wbin.size(); j++)
+				ca.reloc(wbin[j].cref, to);
 		}
 	}
 	// All reasons:
@@ -2092,6 +3370,153 @@ void Solver::relocAll(ClauseAllocator& to) {
 		ca.reloc(clauses[i], to);
 }
 
+void Solver::checkGarbage(double gf) {
+	uint32_t young_size = ca.youngSize();
+	uint32_t old_wasted = ca.wasted() - ca.young_wasted;
+	//collecting the young generation on its own only pays off while the old generation is the larger one
+	bool young = generational_gc && young_size <= ca.size() / 2 && old_wasted <= (ca.size() - young_size) * gf
+			&& ca.young_wasted > young_size * gf;
+	if (!young && ca.wasted() <= ca.size() * gf)
+		return;
+	if (young && !canCollectYoung())
+		young = false;
+	auto start = std::chrono::steady_clock::now();
+	if (young) {
+		collectYoung();
+		stats_gc_young++;
+	} else {
+		garbageCollect();
+		stats_gc_full++;
+	}
+	double pause = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	stats_gc_time += pause;
+	if (pause > stats_gc_max_pause)
+		stats_gc_max_pause = pause;
+}
+
+/*_________________________________________________________________________________________________
+ |
+ |  collectYoung : ()  ->  [void]
+ |
+ |  Description:
+ |    Garbage collect only the young generation of the clause allocator: the clauses allocated since it was last
+ |    promoted, which are mostly learnt clauses. The young clauses are kept at the ends of 'learnts' and 'clauses'
+ |    (which only ever grow at their ends, and are compacted in order; 'reduceDB()' restores this with
+ |    'youngLast()'), so the live ones are found without looking at the old ones. They are slid down in place, in
+ |    address order, and the references to each moved clause are fixed: its watchers are found through its two
+ |    watched literals, and its reason (if it is locked) through the literal that it implies. The lazily detached
+ |    watchers of the freed young clauses are removed by cleaning just the watch lists that they were detached from
+ |    (recorded in 'young_smudged' by 'detachClause()'). So the work is bounded by the young generation and the
+ |    watch lists of its clauses, rather than the whole database. Once the live young clauses exceed
+ |    'gc_young_words', they are promoted to the old generation, which bounds the pause of each young collection;
+ |    the old generation is only collected by the full 'garbageCollect()'.
+ |________________________________________________________________________________________________@*/
+void Solver::collectYoung() {
+	MONOSAT_TRACE_SPAN("collect young", "solver");
+	if (tmp_clause != CRef_Undef) {
+		ca[tmp_clause].mark(1);
+		ca.free(tmp_clause);
+		tmp_clause = CRef_Undef;
+	}
+	// The lazily detached watchers of freed clauses must go first, as their memory is about to be reused:
+	for (int i = 0; i < young_smudged.size(); i++)
+		watches.lookup(young_smudged[i]); //(cleans the list, unless it has been cleaned since)
+	for (int i = 0; i < young_smudged_bin.size(); i++)
+		watches_bin.lookup(young_smudged_bin[i]);
+	young_smudged.clear();
+	young_smudged_bin.clear();
+	
+	CRef young = ca.young_start;
+	int first_learnt = learnts.size();
+	while (first_learnt > 0 && learnts[first_learnt - 1] >= young)
+		first_learnt--;
+	int first_clause = clauses.size();
+	while (first_clause > 0 && clauses[first_clause - 1] >= young)
+		first_clause--;
+	gc_live.clear();
+	for (int i = first_learnt; i < learnts.size(); i++)
+		gc_live.push(learnts[i]);
+	for (int i = first_clause; i < clauses.size(); i++)
+		gc_live.push(clauses[i]);
+	sort(gc_live);
+#ifndef NDEBUG
+	for (int i = 0; i < first_learnt; i++)
+		assert(learnts[i] < young);
+	for (int i = 0; i < first_clause; i++)
+		assert(clauses[i] < young);
+	for (int i = 0; i < trail.size(); i++) {
+		CRef r = reason(var(trail[i]));
+		assert(!(ca.isClause(r) && r >= young && locked(ca[r]))
+				|| std::binary_search((CRef*) gc_live, (CRef*) gc_live + gc_live.size(), r));
+	}
+#endif
+	
+	gc_moved.clear();
+	CRef to = young;
+	for (int i = 0; i < gc_live.size(); i++) {
+		CRef from = gc_live[i];
+		int words = ClauseAllocator::clauseWords(ca[from]);
+		if (from != to) {
+			Lit implied = lockedLit(ca[from]);
+			ca.slide(from, to);
+			relocWatchers(from, to);
+			if (implied != lit_Undef)
+				vardata[var(implied)].reason = to;
+		}
+		gc_moved.push(to);
+		to += words;
+	}
+	
+	auto moved = [&](CRef & cr) {
+		int k = std::lower_bound((CRef*) gc_live, (CRef*) gc_live + gc_live.size(), cr) - (CRef*) gc_live;
+		assert(k < gc_live.size() && gc_live[k] == cr);
+		cr = gc_moved[k];
+	};
+	for (int i = first_learnt; i < learnts.size(); i++)
+		moved(learnts[i]);
+	for (int i = first_clause; i < clauses.size(); i++)
+		moved(clauses[i]);
+	
+	if (verbosity >= 2)
+		printf("|  Young garbage collection:   %12d bytes => %12d bytes       |\n",
+				ca.youngSize() * ClauseAllocator::Unit_Size, (to - young) * ClauseAllocator::Unit_Size);
+	ca.truncateYoung(to);
+	if (to - young > gc_young_words) {
+		ca.young_start = to;
+		stats_gc_promotions++;
+	}
+}
+
+void Solver::youngLast(vec<CRef>& cs) {
+	CRef young = ca.young_start;
+	gc_live.clear();
+	int i, j;
+	for (i = j = 0; i < cs.size(); i++) {
+		if (cs[i] < young)
+			cs[j++] = cs[i];
+		else
+			gc_live.push(cs[i]);
+	}
+	for (i = 0; i < gc_live.size(); i++)
+		cs[j++] = gc_live[i];
+}
+
+void Solver::relocWatchers(CRef from, CRef to) {
+	const Clause & c = ca[to];
+	if (c.size() < 2)
+		return;
+	OccLists<Lit, vec<Watcher>, WatcherDeleted> & ws = c.size() == 2 ? watches_bin : watches;
+	for (int k = 0; k < 2; k++) {
+		vec<Watcher> & w = ws[~c[k]];
+		for (int i = 0; i < w.size(); i++) {
+			if (w[i].cref == from) {
+				w[i].cref = to;
+				break;
+			}
+		}
+	}
+}
+
 void Solver::garbageCollect() {
 	// Initialize the next region to a size corresponding to the estimated utilization degree. This
 	// is not precise but should avoid some unnecessary reallocations for the new region:
@@ -26,6 +26,7 @@
 
 #include "mtl/Vec.h"
 #include "mtl/Heap.h"
+#include "mtl/VMTFQueue.h"
 #include "mtl/Alg.h"
 #include "mtl/Rnd.h"
 #include "utils/Options.h"
@@ -33,7 +34,14 @@
 #include "core/Theory.h"
 #include "core/TheorySolver.h"
 #include "core/Config.h"
+#include "core/ClauseExchange.h"
+#include "core/Profile.h"
+#include "core/Trace.h"
+#include "core/Proof.h"
+#include "core/Snapshot.h"
 #include <cinttypes>
+#include <atomic>
+#include <chrono>
 
 //this is _really_ ugly...
 template<unsigned int D, class T> class GeometryTheorySolver;
@@ -71,9 +79,17 @@ public:
 	virtual bool addClause(Lit p, Lit q, Lit r);                    // Add a ternary clause to the solver.
 	bool addClause_(vec<Lit>& ps);           // Add a clause to the solver without making superflous internal copy. Will
 			
+	// Proof output:
+	//
+	bool openProof(const char * proof_file, const char * formula_file, bool binary); // Write a DRAT proof of unsatisfiability to 'proof_file', for the formula written to 'formula_file' (see core/Proof.h).
+	void closeProof();                                                                // Finish writing the proof (also done when the solver is destroyed).
+
 	void setDecisionPriority(Var v, unsigned int p) {
 		priority[v] = p;
-		if(decision[v]){
+		if (vmtf) {
+			vmtf_queue.setPriority(v, p);
+			insertVarOrder(v);
+		} else if(decision[v]){
 			if (order_heap.inHeap(v))
 				order_heap.decrease(v);
 			else
@@ -82,15 +98,7 @@ public:
 	}
 	
 	//Theory interface
-	void addTheory(Theory*t) {
-		theories.push(t);
-		decidable_theories.push(t);
-		theory_queue.capacity(theories.size());
-		in_theory_queue.push(false);
-		t->setTheoryIndex(theories.size() - 1);
-		cancelUntil(0);
-		resetInitialPropagation();
-	}
+	void addTheory(Theory*t);
 	
 	//Call to force at least one round of propagation to each theory solver at the next solve() call
 	void resetInitialPropagation() {
@@ -124,12 +132,23 @@ public:
 				}
 				markers.shrink(k - l);
 			} else {
-				theories[j++] = theories[i];
-				in_theory_queue[j++] = in_theory_queue[i];
+				theories[j] = theories[i];
+				in_theory_queue[j] = in_theory_queue[i];
+				theory_cost[j] = theory_cost[i];
+				theory_type[j] = theory_type[i];
+#ifdef MONOSAT_PROFILE
+				theory_profile[j] = theory_profile[i];
+#endif
+				j++;
 			}
 		}
 		theories.shrink(i - j);
 		in_theory_queue.shrink(i - j);
+		theory_cost.shrink(i - j);
+		theory_type.shrink(i - j);
+#ifdef MONOSAT_PROFILE
+		theory_profile.shrink(i - j);
+#endif
 		
 		cancelUntil(0);
 	}
@@ -167,6 +186,57 @@ public:
 
         
 		printf("restarts              : %" PRIu64 "\n", starts);
+		if (ema_restart) {
+			printf("blocked restarts      : %" PRIu64 "\n", stats_blocked_restarts);
+		}
+		if (chrono_backtrack) {
+			printf("chrono backtracks     : %" PRIu64 "\n", stats_chrono_backtracks);
+		}
+		if (rephase_interval > 0) {
+			printf("rephases              : %" PRIu64 "\n", stats_rephases);
+		}
+		if (opt_theory_phase_hints) {
+			printf("theory phase hints    : %" PRIu64 "\n", stats_phase_hints);
+		}
+		if (inprocess_interval > 0) {
+			printf("inprocessing          : %" PRIu64 " rounds (%f s), %" PRIu64 " subsumed, %" PRIu64 " vivified (%" PRIu64 " lits removed)\n",
+					stats_inprocess_rounds, stats_inprocess_time, stats_subsumed_learnts, stats_vivified_clauses,
+					stats_vivified_lits);
+		}
+		if (shrink || binary_min || theory_conflict_min) {
+			printf("minimized literals    : %" PRIu64 " shrunk, %" PRIu64 " by binary clauses, %" PRIu64 " from theory conflicts\n",
+					stats_shrunk_lits, stats_binary_min_lits, stats_theory_conflict_min_lits);
+		}
+		if (stats_gc_young || stats_gc_full) {
+			printf("garbage collections   : %" PRIu64 " young, %" PRIu64 " full   (%f s, max pause %f s)\n", stats_gc_young,
+					stats_gc_full, stats_gc_time, stats_gc_max_pause);
+		}
+		if (stats_gc_promotions) {
+			printf("young promotions      : %" PRIu64 "\n", stats_gc_promotions);
+		}
+		if (stats_snapshots) {
+			printf("snapshots             : %" PRIu64 "   (%f s)\n", stats_snapshots, stats_snapshot_time);
+		}
+		if (stats_lookaheads) {
+			printf("cube lookaheads       : %" PRIu64 "   (%" PRIu64 " failed literals)\n", stats_lookaheads, stats_failed_literals);
+		}
+		if (opt_reuse_trail) {
+			printf("reused trail levels   : %" PRIu64 "   (over %" PRIu64 " solves)\n", stats_reused_levels, solves);
+		}
+		if (theories.size()) {
+			printf("theory explanations   : %" PRIu64 " built, %" PRIu64 " reused\n", stats_theory_reasons_built,
+					stats_theory_reasons_reused);
+		}
+		if (proof) {
+			printf("proof                 : %" PRIu64 " added, %" PRIu64 " deleted, %" PRIu64 " theory lemmas (%.1f MB)\n",
+					proof->additions, proof->deletions, proof->lemmas, proof->bytesWritten() / (1024.0 * 1024.0));
+		}
+		if (theory_schedule) {
+			for (int i = 0; i < theories.size(); i++) {
+				printf("theory %-3d schedule   : %.2f us/propagation, %.1f%% yield, %" PRIu64 " deferred\n", i,
+						theory_cost[i].time * 1e6, theory_cost[i].yield * 100, theory_cost[i].deferred);
+			}
+		}
 		printf("conflicts             : %-12" PRIu64 "   (%.0f /sec, %d learnts, %" PRId64 " removed)\n", conflicts,
 				conflicts / cpu_time, learnts.size(), stats_removed_clauses);
 		printf("decisions             : %-12" PRIu64 "   (%4.2f %% random) (%.0f /sec)\n", decisions,
@@ -177,6 +247,21 @@ public:
 		printf("propagations          : %-12" PRIu64 "   (%.0f /sec)\n", propagations, propagations / cpu_time);
 		printf("conflict literals     : %-12" PRIu64 "   (%4.2f %% deleted)\n", tot_literals,
 				(max_literals - tot_literals) * 100 / (double) max_literals);
+		int n_core = 0, n_tier2 = 0, n_local = 0;
+		for (CRef cr : learnts) {
+			LearntTier t = ca[cr].tier();
+			if (t == LearntTier::CORE)
+				n_core++;
+			else if (t == LearntTier::TIER2)
+				n_tier2++;
+			else
+				n_local++;
+		}
+		printf("learnt clause tiers   : %d core, %d tier2, %d local\n", n_core, n_tier2, n_local);
+		if (stats_shared_exported || stats_shared_imported) {
+			printf("shared clauses        : %" PRIu64 " exported, %" PRIu64 " imported\n", stats_shared_exported,
+					stats_shared_imported);
+		}
 		if (opt_detect_pure_theory_lits) {
 			printf("pure literals     : %" PRId64 " (%" PRId64 " theory lits) (%" PRId64 " rounds, %f time)\n", stats_pure_lits,
 					stats_pure_theory_lits, pure_literal_detections, stats_pure_lit_time);
@@ -284,7 +369,9 @@ public:
 		}
 	}
 
-	//Lazily construct a reason for a literal propagated from a theory
+	//Lazily construct a reason for a literal propagated from a theory.
+	//The explanation is attached as a clause and replaces the theory marker as p's reason, so it is reused (rather than
+	//rebuilt by the theory) for as long as p stays on the trail.
 	CRef constructReason(Lit p) {
 		static int iterp =0;
 		if(++iterp==24){
@@ -299,10 +386,19 @@ public:
 		int t = getTheory(cr);
 		assert(hasTheory(p));
 		theory_reason.clear();
+		stats_theory_reasons_built++;
 		if(p.x==269 ){
 			int a =1;
 		}
-		theories[t]->buildReason(getTheoryLit(p), theory_reason, cr);
+		{
+			MONOSAT_PROFILE_SCOPE(theory_profile[t], Reason);
+			int prev_source = proof_source;
+			proof_source = t;
+			theories[t]->buildReason(getTheoryLit(p), theory_reason, cr);
+			proof_source = prev_source;
+		}
+		if (proof)
+			proofLemma(theory_reason, t);
 		assert(theory_reason[0] == p);
 		assert(value(p)==l_True);
 #ifdef DEBUG_SOLVER
@@ -362,6 +458,25 @@ public:
 	virtual bool solve(Lit p, Lit q);            // Search for a model that respects two assumptions.
 	virtual bool solve(Lit p, Lit q, Lit r);     // Search for a model that respects three assumptions.
 	bool okay() const;                  // FALSE means solver is in a conflicting state
+
+	// Cube-and-conquer:
+	//
+	bool cube(const vec<Lit> & assumps, int depth, int n_candidates, vec<vec<Lit>> & out_cubes); // Split the search space under 'assumps' into at most 2^depth cubes, by lookahead on theory atoms.
+	                                                                                              // Each cube begins with 'assumps'. Returns false if every cube was refuted.
+
+	// Checkpoints:
+	//
+	bool writeSnapshot(const char * file);  // Write the search state (learnt clauses, level 0 assignments, activities, phases and statistics) to 'file'.
+	bool loadSnapshot(const char * file);   // Resume from a snapshot written by a solver built from the same input. Returns false if it does not match.
+	void setCheckpoint(const char * file, double interval_seconds); // Write a snapshot to 'file' at the first restart after every 'interval_seconds' (0 to only write on request).
+	void requestCheckpoint(bool then_stop = false) { // Write a snapshot at the next restart; if 'then_stop', interrupt the search after writing it.
+		if (then_stop)                                 // Safe to call from a signal handler.
+			checkpoint_stop = true;
+		checkpoint_requested = true;
+	}
+	void setInputFingerprint(uint64_t fingerprint) { // Identifies the input (e.g., a hash of the input file), so that snapshots are only restored into a solver for the same input.
+		input_fingerprint = fingerprint;
+	}
 	
 	void toDimacs(FILE* f, const vec<Lit>& assumps);            // Write CNF to file in DIMACS-format.
 	void toDimacs(const char *file, const vec<Lit>& assumps);
@@ -398,6 +513,12 @@ public:
 	void budgetOff();
 	void interrupt();          // Trigger a (potentially asynchronous) interruption of the solver.
 	void clearInterrupt();     // Clear interrupt indicator flag.
+
+	// Portfolio clause sharing:
+	//
+	//Share short learnt clauses with the other solvers attached to 'exchange'. Only clauses over the variables
+	//marked in 'shareable' (which must have the same meaning in every solver of the portfolio) are exchanged.
+	void setClauseExchange(ClauseExchange * exchange, int exchange_id, const vec<bool> & shareable);
 	
 	// Memory managment:
 	//
@@ -418,6 +539,7 @@ public:
 	vec<Lit> theory_conflict;
 	vec<Theory*> theories;
 	vec<Theory*> decidable_theories;
+	vec<char> theory_type;      // Which of the compile-time theory set (see 'MONOSAT_THEORY_CALL' in Solver.cc) each theory is, if any.
 	vec<Var> all_theory_vars;
 	struct LitCount {
 		char occurs :1;
@@ -460,12 +582,26 @@ public:
 	double random_var_freq;
 	double random_seed;
 	bool luby_restart;
+	bool ema_restart;        // Restart when the recent LBD of conflicts exceeds its long term average, instead of on a fixed schedule.
+	bool vmtf;               // Use the variable-move-to-front decision heuristic (in 'vmtf_queue') instead of VSIDS (in 'order_heap').
+	bool target_phases;      // Decide with 'target_phase' (where set) instead of 'polarity'.
+	bool theory_schedule;    // Pick theories to propagate by measured cost and yield (see 'nextTheory()'), instead of LIFO.
+	int rephase_interval;    // Conflicts between resets of the saved phases (0 to disable; see 'rephase()').
+	int inprocess_interval;  // Conflicts between rounds of inprocessing (0 to disable; see 'inprocess()').
+	double inprocess_time;   // Fraction of the search time that inprocessing may use.
+	bool chrono_backtrack=false; // Backtrack chronologically after conflicts (set by 'solve_()' from opt_chrono_backtrack, if all theories support it).
 	int ccmin_mode;         // Controls conflict clause minimization (0=none, 1=basic, 2=deep).
+	bool shrink;            // Shrink the literals of each level in learnt clauses to that level's UIP (see 'shrinkClause()').
+	bool binary_min;        // Minimize learnt clauses with the binary clauses of their asserting literal (see 'binaryMinimize()').
+	bool theory_conflict_min; // Minimize theory conflict clauses before learning them (see 'minimizeTheoryConflict()').
 	int phase_saving;       // Controls the level of phase saving (0=none, 1=limited, 2=full).
 	bool rnd_pol;            // Use random polarities for branching heuristics.
 	bool rnd_init_act;       // Initialize variable activities with a small random value.
 	double garbage_frac;       // The fraction of wasted memory allowed before a garbage collection is triggered.
+	bool generational_gc;      // Collect the young generation of clauses on its own, where possible (see 'collectYoung()').
+	uint32_t gc_young_words;   // Promote the young generation once its live clauses exceed this many words.
 	
+	bool decide_theories;    // Allow theory decisions (only has an effect if opt_decide_theories is set).
 	int restart_first; // The initial restart limit.                                                                (default 100)
 	double restart_inc; // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
 	double learntsize_factor; // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
@@ -485,6 +621,32 @@ public:
 	int consecutive_theory_conflicts=0;
 	uint64_t next_theory_decision = 0;
 	uint64_t n_theory_decision_rounds=0;
+	uint64_t stats_shared_exported=0;
+	uint64_t stats_shared_imported=0;
+	uint64_t stats_blocked_restarts=0;
+	uint64_t stats_chrono_backtracks=0;
+	uint64_t stats_reused_levels=0;
+	uint64_t stats_rephases=0;
+	uint64_t stats_phase_hints=0;
+	uint64_t stats_inprocess_rounds=0;
+	uint64_t stats_subsumed_learnts=0;
+	uint64_t stats_vivified_clauses=0;
+	uint64_t stats_vivified_lits=0;
+	double stats_inprocess_time=0;
+	uint64_t stats_lookaheads=0;
+	uint64_t stats_snapshots=0;
+	double stats_snapshot_time=0;
+	uint64_t stats_failed_literals=0;
+	uint64_t stats_shrunk_lits=0;          // Literals removed from learnt clauses by 'shrinkClause()'.
+	uint64_t stats_binary_min_lits=0;      // Literals removed from learnt clauses by 'binaryMinimize()'.
+	uint64_t stats_theory_conflict_min_lits=0; // Literals removed from theory conflict clauses by 'minimizeTheoryConflict()'.
+	uint64_t stats_gc_young=0;
+	uint64_t stats_gc_full=0;
+	uint64_t stats_gc_promotions=0; // Young collections after which the young generation was promoted to the old one.
+	double stats_gc_time=0;
+	double stats_gc_max_pause=0;
+	uint64_t stats_theory_reasons_built=0;  // Theory propagations explained by their theory (see 'constructReason()').
+	uint64_t stats_theory_reasons_reused=0; // Theory propagations whose explanation was already attached as a reason clause.
 
 	//Var last_dec=var_Undef;
 protected:
@@ -537,6 +699,16 @@ protected:
 		}
 	};
 
+	struct LevelGt {
+		const Solver & S;
+		LevelGt(const Solver & S) :
+				S(S) {
+		}
+		bool operator ()(Lit x, Lit y) const {
+			return S.level(var(x)) > S.level(var(y));
+		}
+	};
+
 	struct VarOrderLt {
 		const vec<double>& activity;
 		const vec<int> & priority;
@@ -569,6 +741,66 @@ protected:
 		}
 	};
 
+	//Exponential moving average, with a bias correction for the first samples:
+	//the smoothing factor starts at 1 and is halved after 1, 3, 7, 15... samples until it reaches 'alpha'.
+	struct EMA {
+		double value = 0;
+		double alpha;
+		double beta = 1;
+		uint64_t wait = 0;
+		uint64_t period = 0;
+		EMA(double alpha) :
+				alpha(alpha) {
+		}
+		void update(double x) {
+			value += beta * (x - value);
+			if (beta > alpha && wait-- == 0) {
+				wait = period = 2 * (period + 1) - 1;
+				beta *= 0.5;
+				if (beta < alpha)
+					beta = alpha;
+			}
+		}
+		operator double() const {
+			return value;
+		}
+	};
+
+	// Measured cost of propagating each theory (if 'theory_schedule' is set):
+	//
+	struct TheoryCost {
+		EMA time { 1.0 / 32 };   // Seconds per call to 'propagateTheory()'.
+		EMA yield { 1.0 / 32 };  // Fraction of calls that found a conflict or implied a literal.
+		uint64_t deferred = 0;   // Times this theory was postponed until the literal queue was empty.
+	};
+	vec<TheoryCost> theory_cost;
+#ifdef MONOSAT_PROFILE
+	vec<Profiler::Site*> theory_profile; // Where to record the time spent in each theory (see core/Profile.h).
+#endif
+
+	// Proof output (see core/Proof.h):
+	//
+	enum {
+		ProofInput = -1,  // A clause given to the solver.
+		ProofLogged = -2  // A clause that is already in the proof (such as a resolvent from variable elimination).
+	};
+	ProofWriter * proof = nullptr;
+	int proof_source = ProofInput; // Origin of the clauses passed to 'addClause_()': one of the above, or the index of the theory being run.
+
+	void proveLevelZero();        // Log the reasons of the theory literals that were implied at level 0, as lemmas.
+
+	void proofLemma(const vec<Lit> & ps, int theoryID) {
+		proof->lemma(ps, theoryID, theoryID >= 0 ? &typeid(*theories[theoryID]) : nullptr);
+	}
+	void proofClause(const vec<Lit> & ps) { // Record a clause from 'proof_source'.
+		if (proof_source == ProofLogged)
+			return;
+		else if (proof_source == ProofInput)
+			proof->input(ps);
+		else
+			proofLemma(ps, proof_source);
+	}
+
 	// Solver state:
 	//
 	bool ok;            // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
@@ -578,8 +810,26 @@ protected:
 	vec<double> activity;         // A heuristic measurement of the activity of a variable.
 	double var_inc;          // Amount to bump next variable with.
 	OccLists<Lit, vec<Watcher>, WatcherDeleted> watches; // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
+	OccLists<Lit, vec<Watcher>, WatcherDeleted> watches_bin; // Binary clauses, watched like 'watches', but with the other literal of the clause as the blocker,
+	                                                         // so that they can be propagated without inspecting the clause.
 	vec<lbool> assigns;          // The current assignments.
 	vec<char> polarity;         // The preferred polarity of each variable.
+	vec<char> original_phase;   // The polarity each variable was created with (or last given by 'setPolarity()').
+	vec<char> target_phase;     // The polarity of each variable in the largest conflict-free trail since the last restart (2 if unknown).
+	vec<char> best_phase;       // The polarity of each variable in the largest conflict-free trail since the last rephase (2 if unknown).
+	int target_assigned = 0;    // Size of the trail that 'target_phase' was recorded from.
+	int best_assigned = 0;      // Size of the trail that 'best_phase' was recorded from.
+	uint64_t next_rephase = 0;  // Conflict count at which to next call 'rephase()'.
+	int n_rephases = 0;
+	uint64_t next_inprocess = 0; // Conflict count at which to next call 'inprocess()'.
+	std::chrono::steady_clock::time_point last_inprocess = std::chrono::steady_clock::now();
+	vec<vec<CRef>> learnt_occs;  // Learnt clauses containing each literal (only used by 'subsumeLearnts()').
+	vec<CRef> vivify_queue;
+	vec<Lit> vivify_clause;
+	vec<Lit> phase_hints;
+	bool phase_hints_pending = false; // Whether 'best_phase' grew at the last conflict, and is still to be extended by the theories.
+	vec<uint32_t> best_stamp;   // 'best_generation' if the variable was assigned in the trail that 'best_phase' was last recorded from.
+	uint32_t best_generation = 0;
 	vec<char> decision;         // Declares if a variable is eligible for selection in the decision heuristic.
 	vec<int> priority;		  // Static, lexicographic heuristic
 	vec<TheoryData> theory_vars;
@@ -592,7 +842,10 @@ protected:
 	int simpDB_assigns;   // Number of top-level assignments since last execution of 'simplify()'.
 	int64_t simpDB_props;   // Remaining number of propagations that must be made before next execution of 'simplify()'.
 	vec<Lit> assumptions;      // Current set of assumptions provided to solve by the user.
+	vec<Lit> trail_assumptions; // The assumptions of the previous solve that decision levels 1..trail_assumptions.size() were made for.
 	Heap<VarOrderLt> order_heap;       // A priority queue of variables ordered with respect to the variable activity.
+	VMTFQueue vmtf_queue;              // Variables by priority, then by how recently they were bumped (if 'vmtf' is set).
+	vec<Var> vmtf_bumped;              // Variables to move to the front of 'vmtf_queue' after conflict analysis.
 	//Heap<LazyLevelLt> lazy_heap;       // A priority queue of variables to be propagated at earlier levels, lazily.
 	double progress_estimate;       // Set by 'search()'.
 	bool remove_satisfied; // Indicates whether possibly inefficient linear scan for satisfied clauses should be performed in 'simplify'.
@@ -606,10 +859,27 @@ protected:
 	vec<Lit> analyze_stack;
 	vec<Lit> analyze_toclear;
 	vec<Lit> add_tmp;
+	vec<uint64_t> lbd_seen;     // Per decision level, the last 'lbd_stamp' that counted it (see 'computeLBD()').
+	uint64_t lbd_stamp = 0;
+	vec<uint64_t> min_seen;     // Per variable, the last 'min_stamp' that marked it (see 'shrinkLevel()' and 'binaryMinimize()').
+	uint64_t min_stamp = 0;
+	vec<CRef> reduce_tmp;
+	vec<CRef> gc_live;          // The live clauses of the young generation, in address order (see 'collectYoung()').
+	vec<CRef> gc_moved;         // Where each clause of 'gc_live' was moved to.
+	vec<Lit> young_smudged;     // The watch lists that young clauses were lazily detached from, since the last collection.
+	vec<Lit> young_smudged_bin; // The same, for the binary watch lists.
+	int n_core_learnts = 0;     // Learnt clauses in the core tier (exact after each 'reduceDB()').
 
 	vec<vec<Lit>> clauses_to_add;
 
 	double max_learnts=1;
+
+	// Dynamic restarts (see 'noteConflict()'):
+	//
+	EMA lbd_ema_fast{opt_restart_ema_fast};
+	EMA lbd_ema_slow{opt_restart_ema_slow};
+	EMA trail_ema{opt_restart_ema_slow};
+	uint64_t restart_conflicts=0;   // Conflicts (including theory conflicts resolved outside of 'search()') since the last restart.
 	double learntsize_adjust_confl=0;
 	int learntsize_adjust_cnt=0;
 
@@ -617,7 +887,24 @@ protected:
 	//
 	int64_t conflict_budget;    // -1 means no budget.
 	int64_t propagation_budget; // -1 means no budget.
-	bool asynch_interrupt=false;
+	std::atomic<bool> asynch_interrupt{false};
+
+	// Checkpoints:
+	//
+	std::string checkpoint_file;
+	double checkpoint_interval = 0;
+	std::chrono::steady_clock::time_point next_checkpoint;
+	std::atomic<bool> checkpoint_requested{false};
+	std::atomic<bool> checkpoint_stop{false};
+	uint64_t input_fingerprint = 0;
+
+	// Portfolio clause sharing:
+	//
+	ClauseExchange * exchange=nullptr;
+	int exchange_id=-1;
+	vec<bool> shareable;
+	vec<uint64_t> import_cursors;
+	vec<Lit> import_tmp;
 
 	// Main internal methods:
 	//
@@ -657,14 +944,40 @@ public:
 	}
 protected:
 	void analyze(CRef confl, vec<Lit>& out_learnt, int& out_btlevel);    // (bt = backtrack)
+	int nextTheory(bool literals_pending);                     // Remove the next theory to propagate from 'theory_queue' (-1 if none should run yet).
+	bool runTheory(int theoryID);                              // Propagate a theory into 'theory_conflict', measuring its cost.
 	void analyzeFinal(CRef confl, Lit skip_lit, vec<Lit>& out_conflict);
 	void analyzeFinal(Lit p, vec<Lit>& out_conflict); // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
 	bool litRedundant(Lit p, uint32_t abstract_levels);                       // (helper method for 'analyze()')
+	void shrinkClause(vec<Lit>& ps, int first);                   // Shrink the literals of each level in 'ps' (from 'first') to that level's UIP.
+	Lit shrinkLevel(const vec<Lit>& ps, int begin, int end, int lev); // The UIP of the literals 'ps[begin..end)' at level 'lev', or lit_Undef.
+	void binaryMinimize(vec<Lit>& out_learnt);                    // Remove literals implied by '~out_learnt[0]' through binary clauses.
+	void minimizeTheoryConflict(vec<Lit>& ps);                    // Minimize a theory conflict clause (all of its literals false).
 	lbool search(int nof_conflicts);                                     // Search for a given number of conflicts.
+	void noteConflict(unsigned lbd, int trail_size);           // Update the dynamic restart averages with a new conflict.
+	bool restartDue(int nof_conflicts, int conflictC) const;    // True if 'search()' should restart now.
+	void updatePhases();                                        // Record the conflict-free prefix of the trail in 'target_phase' and 'best_phase'.
+	void addTheoryPhaseHints();                                 // Let the theories extend 'best_phase' (after backtracking from the conflict).
+	void rephase();                                             // Reset the saved phases, cycling through original, best, inverted and random phases.
+	bool inprocess();                                           // Simplify the clause database between restarts. Returns false if the solver became unsatisfiable.
+	void subsumeLearnts(std::chrono::steady_clock::time_point deadline); // Remove learnt clauses that are subsumed by other clauses.
+	bool vivifyLearnts(std::chrono::steady_clock::time_point deadline);  // Shorten learnt clauses by propagating the negations of their literals.
+	bool assertCube(const vec<Lit> & cube);                     // Backtrack to level 0, then assign each literal of 'cube' at its own decision level. Returns false on a conflict.
+	uint64_t snapshotLayout();                                  // Hash of the input fingerprint, the variables and the theory atoms they map to, to check that a snapshot belongs to this solver.
+	int lookahead(Lit l);                                       // Number of theory atoms assigned by propagating 'l' (-1 on a conflict, -2 if a theory conflict backjumped).
+	void splitCube(vec<Lit> & prefix, int depth, const vec<Var> & candidates, vec<vec<Lit>> & out_cubes);
+	bool decisionPolarity(Var v);                               // The polarity to decide 'v' with.
 	lbool solve_();                                           // Main solve method (assumptions given in 'assumptions').
+	int reusableTrailLevel() const;             // Number of leading decision levels that the next solve can keep (see opt_reuse_trail).
+	void exportClause(const vec<Lit> & clause);              // Offer a learnt clause to the other solvers of the portfolio.
+	bool importClauses();                                      // Add the clauses shared by the other solvers (at level 0).
 	void reduceDB();                                                      // Reduce the set of learnt clauses.
+	template<class Lits>
+	unsigned computeLBD(const Lits & lits);                   // Number of distinct decision levels among 'lits'.
+	void setLearntLBD(Clause & c, unsigned lbd);                 // Set the LBD of a learnt clause, promoting it to a better tier.
 	void removeSatisfied(vec<CRef>& cs);                           // Shrink 'cs' to contain only non-satisfied clauses.
 	void rebuildOrderHeap();
+	void vmtfBumpAnalyzed();                         // Move the variables bumped during conflict analysis to the front of 'vmtf_queue'.
 
 	// Maintaining Variable/Clause activity:
 	//
@@ -681,9 +994,17 @@ protected:
 	void detachClause(CRef cr, bool strict = false); // Detach a clause to watcher lists.
 	void removeClause(CRef cr);               // Detach and free a clause.
 	bool locked(const Clause& c) const; // Returns TRUE if a clause is a reason for some implication in the current state.
+	Lit lockedLit(const Clause& c) const; // The literal that a clause is the reason for, or lit_Undef if it is not locked.
+	void binaryReasonFirst(Clause& c, Var x); // Move the literal of 'x' to the front of a binary reason clause, as analysis expects.
 	bool satisfied(const Clause& c) const; // Returns TRUE if a clause is satisfied in the current state.
 			
 	void relocAll(ClauseAllocator& to);
+	void collectYoung();                      // Compact the young generation of the clause allocator in place.
+	void youngLast(vec<CRef>& cs);            // Move the young clauses of 'cs' behind the old ones (see 'collectYoung()').
+	void relocWatchers(CRef from, CRef to);   // Point the watchers of the (moved) clause at 'to', from 'from'.
+	virtual bool canCollectYoung() {          // False while other references to clauses exist that 'collectYoung()' would not update.
+		return true;
+	}
 public:
 	// Misc:
 	//
@@ -770,7 +1091,10 @@ inline int Solver::level(Var x) const {
 }
 
 inline void Solver::insertVarOrder(Var x) {
-	if (!order_heap.inHeap(x) && decision[x])
+	if (vmtf) {
+		if (decision[x])
+			vmtf_queue.update(x);
+	} else if (!order_heap.inHeap(x) && decision[x])
 		order_heap.insert(x);
 }
 
@@ -808,10 +1132,6 @@ inline void Solver::claBumpActivity(Clause& c) {
 inline void Solver::checkGarbage(void) {
 	return checkGarbage(garbage_frac);
 }
-inline void Solver::checkGarbage(double gf) {
-	if (ca.wasted() > ca.size() * gf)
-		garbageCollect();
-}
 
 // NOTE: enqueue does not set the ok flag! (only public methods do)
 inline bool Solver::enqueue(Lit p, CRef from) {
@@ -844,11 +1164,20 @@ inline bool Solver::addClause(Lit p, Lit q, Lit r) {
 	return addClause_(add_tmp);
 }
 inline bool Solver::locked(const Clause& c) const {
-	CRef r = reason(var(c[0]));
-	bool isClause = ca.isClause(r);
-	if (!isClause)
-		return false;
-	return value(c[0]) == l_True && ca.isClause(reason(var(c[0]))) && ca.lea(reason(var(c[0]))) == &c;
+	return lockedLit(c) != lit_Undef;
+}
+inline Lit Solver::lockedLit(const Clause& c) const {
+	//The implied literal of a binary clause may be in either position (see 'watches_bin')
+	for (int i = 0; i < (c.size() == 2 ? 2 : 1); i++) {
+		CRef r = reason(var(c[i]));
+		if (value(c[i]) == l_True && ca.isClause(r) && ca.lea(r) == &c)
+			return c[i];
+	}
+	return lit_Undef;
+}
+inline void Solver::binaryReasonFirst(Clause& c, Var x) {
+	if (c.size() == 2 && var(c[0]) != x)
+		std::swap(c[0], c[1]);
 }
 inline void Solver::newDecisionLevel() {
 	trail_lim.push(trail.size());
@@ -894,6 +1223,15 @@ inline int Solver::nFreeVars() const {
 }
 inline void Solver::setPolarity(Var v, bool b) {
 	polarity[v] = b;
+	original_phase[v] = b;
+	target_phase[v] = 2;
+}
+inline bool Solver::decisionPolarity(Var v) {
+	if (rnd_pol)
+		return drand(random_seed) < 0.5;
+	if (target_phases && target_phase[v] != 2)
+		return target_phase[v];
+	return polarity[v];
 }
 inline void Solver::setDecisionVar(Var v, bool b) {
 	if (b && !decision[v])
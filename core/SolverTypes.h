@@ -25,6 +25,7 @@
 #define Minisat_SolverTypes_h
 
 #include <assert.h>
+#include <cstring>
 
 #include "mtl/IntTypes.h"
 #include "mtl/Alg.h"
@@ -170,6 +171,13 @@ inline lbool toLbool(int v) {
 class Clause;
 typedef RegionAllocator<uint32_t>::Ref CRef;
 
+//Learnt clauses are kept in one of three tiers, according to their literal block distance (LBD):
+//core clauses are never deleted, tier2 clauses are kept as long as they keep being used in conflict analysis,
+//and local clauses are deleted by activity.
+enum class LearntTier {
+	LOCAL = 0, TIER2 = 1, CORE = 2
+};
+
 class Clause {
 	struct {
 		unsigned mark :2;
@@ -178,6 +186,10 @@ class Clause {
 		unsigned reloced :1;
 		unsigned fromTheory :1;
 		unsigned size :26;
+		unsigned lbd :28;
+		unsigned tier :2;
+		unsigned used :1;
+		unsigned vivified :1;
 	} header;
 	union {
 		Lit lit;
@@ -197,6 +209,10 @@ class Clause {
 		header.reloced = 0;
 		header.size = ps.size();
 		header.fromTheory = 0;
+		header.lbd = 0;
+		header.tier = (unsigned) LearntTier::LOCAL;
+		header.used = 0;
+		header.vivified = 0;
 		
 		for (int i = 0; i < ps.size(); i++)
 			data[i].lit = ps[i];
@@ -261,6 +277,34 @@ public:
 		header.fromTheory = t;
 	}
 	
+	//The literal block distance of the clause, when it was learnt (or last improved during conflict analysis).
+	unsigned lbd() const {
+		return header.lbd;
+	}
+	void setLBD(unsigned lbd) {
+		header.lbd = lbd < (1u << 28) ? lbd : (1u << 28) - 1;
+	}
+	LearntTier tier() const {
+		return (LearntTier) header.tier;
+	}
+	void setTier(LearntTier t) {
+		header.tier = (unsigned) t;
+	}
+	//True if the clause was used in conflict analysis since the last reduction of the learnt clause database.
+	bool used() const {
+		return header.used;
+	}
+	void setUsed(bool u) {
+		header.used = u;
+	}
+	//True if the clause has already been vivified during inprocessing (see 'Solver::inprocess()').
+	bool vivified() const {
+		return header.vivified;
+	}
+	void setVivified(bool v) {
+		header.vivified = v;
+	}
+
 	bool reloced() const {
 		return header.reloced;
 	}
@@ -288,6 +332,10 @@ public:
 		assert(header.has_extra);
 		return data[header.size].act;
 	}
+	float activity() const {
+		assert(header.has_extra);
+		return data[header.size].act;
+	}
 	uint32_t abstraction() const {
 		assert(header.has_extra);
 		return data[header.size].abs;
@@ -317,6 +365,10 @@ class ClauseAllocator: public RegionAllocator<uint32_t> {
 public:
 	bool extra_clause_field;
 	CRef marker_refs;
+	// The young generation: clauses at or above 'young_start' were allocated since it was last promoted
+	// (see 'Solver::collectYoung()'); 'young_wasted' counts the words freed among them.
+	Ref young_start;
+	uint32_t young_wasted;
 
 	CRef makeMarkerReference() {
 		return --marker_refs;
@@ -326,16 +378,40 @@ public:
 		return cr < marker_refs;
 	}
 	
+	//Number of words that 'c' occupies in the allocator.
+	static int clauseWords(const Clause & c) {
+		return clauseWord32Size(c.size(), c.has_extra());
+	}
 	ClauseAllocator(uint32_t start_cap) :
-			RegionAllocator<uint32_t>(start_cap), extra_clause_field(false), marker_refs(CRef_Undef) {
+			RegionAllocator<uint32_t>(start_cap), extra_clause_field(false), marker_refs(CRef_Undef), young_start(0), young_wasted(
+					0) {
 	}
 	ClauseAllocator() :
-			extra_clause_field(false), marker_refs(CRef_Undef) {
+			extra_clause_field(false), marker_refs(CRef_Undef), young_start(0), young_wasted(0) {
 	}
 	
 	void moveTo(ClauseAllocator& to) {
 		to.extra_clause_field = extra_clause_field;
 		RegionAllocator<uint32_t>::moveTo(to);
+		//a freshly collected region holds no garbage, so all of it is promoted to the old generation
+		to.young_start = to.size();
+		to.young_wasted = 0;
+	}
+	
+	uint32_t youngSize() const {
+		return size() - young_start;
+	}
+	//Move the clause at 'from' down to 'to' (which must not be above it), leaving the words in between as garbage.
+	void slide(CRef from, CRef to) {
+		assert(to <= from);
+		memmove(RegionAllocator<uint32_t>::lea(to), RegionAllocator<uint32_t>::lea(from),
+				clauseWords(operator[](from)) * sizeof(uint32_t));
+	}
+	//Discard the young generation from 'new_size' up (all of its live clauses must have been slid below 'new_size').
+	void truncateYoung(Ref new_size) {
+		assert(new_size >= young_start);
+		truncate(new_size, young_wasted);
+		young_wasted = 0;
 	}
 	
 	template<class Lits>
@@ -373,7 +449,10 @@ public:
 			return;
 		}
 		Clause& c = operator[](cid);
-		RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra()));
+		int words = clauseWord32Size(c.size(), c.has_extra());
+		RegionAllocator<uint32_t>::free(words);
+		if (cid >= young_start)
+			young_wasted += words;
 	}
 	
 	void reloc(CRef& cr, ClauseAllocator& to) {
@@ -390,6 +469,10 @@ public:
 		cr = to.alloc(c, c.learnt());
 		c.relocate(cr);
 		to[cr].setFromTheory(c.fromTheory());
+		to[cr].setLBD(c.lbd());
+		to[cr].setTier(c.tier());
+		to[cr].setUsed(c.used());
+		to[cr].setVivified(c.vivified());
 		// Copy extra data-fields: 
 		// (This could be cleaned-up. Generalize Clause-constructor to be applicable here instead?)
 		to[cr].mark(c.mark());
@@ -423,6 +506,9 @@ public:
 	Vec& operator[](const Idx& idx) {
 		return occs[toInt(idx)];
 	}
+	const Vec& operator[](const Idx& idx) const {
+		return occs[toInt(idx)];
+	}
 	Vec& lookup(const Idx& idx) {
 		if (dirty[toInt(idx)])
 			clean(idx);
@@ -41,6 +41,8 @@ public:
 	virtual void setTheoryIndex(int id)=0;
 	virtual void backtrackUntil(int untilLevel)=0;
 	virtual void newDecisionLevel()=0;
+	//Note: if supportsChronologicalBacktracking() returns true, then p may be assigned at a lower level than the current decision level.
+	//The theory solver may treat it as an assignment at the current level; if that level is later backtracked, the SAT solver will enqueue p again.
 	virtual void enqueueTheory(Lit p)=0;
 	virtual bool propagateTheory(vec<Lit> & conflict)=0;
 	virtual bool solveTheory(vec<Lit> & conflict)=0;
@@ -57,6 +59,16 @@ public:
 	virtual bool supportsLazyBacktracking(){
 		return false;
 	}
+	//True if this theory accepts literals that were assigned out of order, at a lower level than the current decision level
+	//(as happens when the SAT solver backtracks chronologically).
+	virtual bool supportsChronologicalBacktracking(){
+		return false;
+	}
+	//Suggest phases for the SAT solver to try for (unassigned) literals of this theory, such as the literals of a witness
+	//for the theory's currently asserted properties. The literals must be in the SAT solver's variable space.
+	virtual void addPhaseHints(vec<Lit> & hints){
+
+	}
 
 
 
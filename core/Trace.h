@@ -0,0 +1,193 @@
+/****************************************************************************************[Trace.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Monosat {
+
+/**
+ * Timeline tracing, in the Chrome Trace Event format (readable by chrome://tracing and Perfetto).
+ *
+ * Tracing is off unless Trace::open() is called (the solver does so if -trace-file is set); while it is off,
+ * each traced span costs a single test of a flag.
+ * Each thread records its events into its own fixed size ring buffer (keeping only the most recent events, if it overflows),
+ * without any locking; the buffers are written to the trace file when the process exits.
+ */
+class Trace {
+public:
+	struct Event {
+		const char * name;
+		const char * category;
+		uint64_t start;     //nanoseconds since the trace was opened
+		uint64_t duration;  //nanoseconds (spans only)
+		int64_t arg;        //optional integer argument (-1 if unused)
+		char phase;         //'X' for a span, 'i' for an instant event
+	};
+
+	static bool enabled() {
+		return state().enabled.load(std::memory_order_relaxed);
+	}
+
+	//Start tracing into 'filename', keeping the last 'events_per_thread' events of each thread. Only the first call has any effect.
+	static void open(const char * filename, int events_per_thread) {
+		State & s = state();
+		std::lock_guard<std::mutex> lock(s.mutex);
+		if (s.enabled)
+			return;
+		s.filename = filename;
+		s.capacity = events_per_thread > 0 ? events_per_thread : 1;
+		s.epoch = std::chrono::steady_clock::now();
+		atexit(write);
+		s.enabled.store(true);
+	}
+
+	static uint64_t now() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - state().epoch).count();
+	}
+
+	static void record(const char * name, const char * category, uint64_t start, uint64_t duration, int64_t arg,
+			char phase) {
+		Buffer & b = buffer();
+		Event & e = b.events[b.head % b.events.size()];
+		b.head++;
+		e.name = name;
+		e.category = category;
+		e.start = start;
+		e.duration = duration;
+		e.arg = arg;
+		e.phase = phase;
+	}
+
+	static void instant(const char * name, const char * category, int64_t arg = -1) {
+		if (enabled())
+			record(name, category, now(), 0, arg, 'i');
+	}
+
+	//Write all buffered events to the trace file (called automatically at exit).
+	static void write() {
+		State & s = state();
+		std::lock_guard<std::mutex> lock(s.mutex);
+		FILE * f = fopen(s.filename.c_str(), "w");
+		if (!f) {
+			fprintf(stderr, "Could not open trace file %s\n", s.filename.c_str());
+			return;
+		}
+		fprintf(f, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+		bool first = true;
+		for (size_t tid = 0; tid < s.buffers.size(); tid++) {
+			Buffer & b = *s.buffers[tid];
+			uint64_t size = b.events.size();
+			uint64_t begin = b.head > size ? b.head - size : 0;
+			fprintf(f, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %zu, \"args\": {\"name\": \"solver thread %zu\"}}",
+					first ? "" : ",\n", tid, tid);
+			first = false;
+			if (begin > 0) {
+				fprintf(f, ",\n{\"name\": \"dropped %" PRIu64 " earlier events\", \"cat\": \"trace\", \"ph\": \"i\", \"s\": \"t\", \"pid\": 1, \"tid\": %zu, \"ts\": %.3f}",
+						begin, tid, b.events[begin % size].start / 1000.0);
+			}
+			for (uint64_t i = begin; i < b.head; i++) {
+				Event & e = b.events[i % size];
+				fprintf(f, ",\n{\"name\": \"%s\", \"cat\": \"%s\", \"ph\": \"%c\", \"pid\": 1, \"tid\": %zu, \"ts\": %.3f", e.name,
+						e.category, e.phase, tid, e.start / 1000.0);
+				if (e.phase == 'X')
+					fprintf(f, ", \"dur\": %.3f", e.duration / 1000.0);
+				else
+					fprintf(f, ", \"s\": \"t\"");
+				if (e.arg >= 0)
+					fprintf(f, ", \"args\": {\"id\": %" PRId64 "}", e.arg);
+				fprintf(f, "}");
+			}
+		}
+		fprintf(f, "\n]}\n");
+		fclose(f);
+	}
+
+private:
+	struct Buffer {
+		std::vector<Event> events;
+		uint64_t head = 0;
+	};
+	struct State {
+		std::atomic<bool> enabled { false };
+		std::mutex mutex;
+		std::string filename;
+		int capacity = 0;
+		std::chrono::steady_clock::time_point epoch;
+		std::vector<std::unique_ptr<Buffer>> buffers;
+	};
+	static State & state() {
+		static State * s = new State(); //never destroyed, as it is written from an atexit() handler
+		return *s;
+	}
+	static Buffer & buffer() {
+		static thread_local Buffer * b = nullptr;
+		if (!b) {
+			State & s = state();
+			std::lock_guard<std::mutex> lock(s.mutex);
+			s.buffers.emplace_back(new Buffer());
+			b = s.buffers.back().get();
+			b->events.resize(s.capacity);
+		}
+		return *b;
+	}
+};
+
+//Records a span from its construction to its destruction (if tracing is enabled).
+class TraceSpan {
+	const char * name;
+	const char * category;
+	int64_t arg;
+	uint64_t start;
+	bool active;
+public:
+	TraceSpan(const char * name, const char * category, int64_t arg = -1) :
+			name(name), category(category), arg(arg), start(0), active(Trace::enabled()) {
+		if (active)
+			start = Trace::now();
+	}
+	~TraceSpan() {
+		if (active)
+			Trace::record(name, category, start, Trace::now() - start, arg, 'X');
+	}
+};
+
+}
+
+#define MONOSAT_TRACE_CONCAT_(a, b) a##b
+#define MONOSAT_TRACE_CONCAT(a, b) MONOSAT_TRACE_CONCAT_(a, b)
+//Trace the rest of the enclosing scope as a span named 'name' (a string literal), in 'category'.
+//An optional integer argument (such as a theory ID) can be attached to the span.
+#define MONOSAT_TRACE_SPAN(...) Monosat::TraceSpan MONOSAT_TRACE_CONCAT(trace_span_, __LINE__)(__VA_ARGS__)
+#define MONOSAT_TRACE_INSTANT(...) Monosat::Trace::instant(__VA_ARGS__)
+
+#endif /* TRACE_H_ */
@@ -433,6 +433,7 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("BFSReachability::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 		
@@ -503,6 +504,7 @@ public:
 		}
 		
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("BFSReachability full update", "graph");
 		
 		q.clear();
 		for (int i = 0; i < g.nodes(); i++) {
@@ -779,6 +781,7 @@ public:
 	}
 	
 	void update() {
+		MONOSAT_TRACE_SPAN("UnweightedBFS::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 		
@@ -787,6 +790,7 @@ public:
 			return;
 		}
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("UnweightedBFS full update", "graph");
 		
 		if (last_deletion == g.deletions) {
 			stats_num_skipable_deletions++;
@@ -58,6 +58,7 @@ public:
 	}
 	
 	void update() {
+		MONOSAT_TRACE_SPAN("Chokepoint::update", "graph");
 		
 		in_queue.clear();
 		queue.clear();
@@ -406,6 +406,7 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("DFSReachability::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 		
@@ -481,6 +482,7 @@ public:
 		}
 		
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("DFSReachability full update", "graph");
 		
 		q.clear();
 		for (int i = 0; i < g.nodes(); i++) {
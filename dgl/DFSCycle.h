@@ -220,6 +220,7 @@ public:
 
 
 	void update() {
+		MONOSAT_TRACE_SPAN("DFSCycle::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 
@@ -238,6 +239,7 @@ public:
 
 
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("DFSCycle full update", "graph");
 
 		computeCycles();
 
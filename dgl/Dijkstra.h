@@ -112,6 +112,7 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("Dijkstra::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 		
@@ -162,6 +163,7 @@ public:
 		}
 		
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("Dijkstra full update", "graph");
 		if (dist.size() != g.nodes()) {
 			
 /*			inf() = 1;
@@ -525,6 +527,7 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("UnweightedDijkstra::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 		
@@ -588,6 +591,7 @@ public:
 		 }*/
 
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("UnweightedDijkstra full update", "graph");
 
 		dist.resize(g.nodes());
 		prev.resize(g.nodes());
@@ -122,9 +122,11 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("DijkstraAllPairs::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("DijkstraAllPairs full update", "graph");
 		
 		if (last_modification > 0 && g.modifications == last_modification) {
 			stats_skipped_updates++;
@@ -136,6 +138,7 @@ public:
 		}
 		INF = g.nodes() + 1;
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("DijkstraAllPairs full update", "graph");
 		
 		setNodes(g.nodes());
 		q.clear();
@@ -848,6 +848,7 @@ public:
 		last_modification = g.modifications - 1;
 	}
 	const Weight maxFlow(int s, int t) {
+		MONOSAT_TRACE_SPAN("DinitzLinkCut::maxFlow", "graph");
 		Weight f = 0;
 #ifdef RECORD
 		if (g.outfile) {
@@ -97,6 +97,7 @@ public:
 	}
 	
 	void update() {
+		MONOSAT_TRACE_SPAN("DisjointSetsConnectedComponents::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 		
@@ -105,6 +106,7 @@ public:
 			return;
 		}
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("DisjointSetsConnectedComponents full update", "graph");
 		
 		if (last_deletion == g.deletions) {
 			stats_num_skipable_deletions++;
@@ -281,6 +281,7 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("DynamicConnectivity::update", "graph");
 		
 		int local_it = ++iteration;
 		
@@ -289,6 +290,7 @@ public:
 			return;
 		}
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("DynamicConnectivity full update", "graph");
 		
 		setNodes(g.nodes());
 		hasPrev = false;
@@ -32,6 +32,7 @@
 
 #include <cstdio>
 #endif
+#include "core/Trace.h"
 
 
 namespace dgl {
@@ -212,6 +213,15 @@ public:
 		return isEdge(edgeID);
 	}
 	//Instead of actually adding and removing edges, tag each edge with an 'enabled/disabled' label, and just expect reading algorithms to check and respect that label.
+	//Preallocate storage for n edges in total (edges can still be added beyond that).
+	void reserveEdges(int n) {
+		if (n <= 0)
+			return;
+		edge_status.reserve(n);
+		edge_status_const.reserve(n);
+		all_edges.reserve(n);
+		weights.reserve(n);
+	}
 	int addEdge(int from, int to, int id = -1, Weight weight=1){
 		assert(from < num_nodes);
 		assert(to < num_nodes);
@@ -612,6 +622,7 @@ public:
 			history_offset=0;
 			history.clear();
 			historyclears++;
+			MONOSAT_TRACE_INSTANT("clearHistory", "graph");
 #ifdef RECORD
 			if (outfile) {
 				fprintf(outfile, "clearHistory\n");
@@ -186,6 +186,7 @@ public:
 		last_modification = g.modifications - 1;
 	}
 	const Weight maxFlow(int s, int t) {
+		MONOSAT_TRACE_SPAN("EdmondsKarp::maxFlow", "graph");
 		if (last_modification > 0 && g.modifications == last_modification) {
 			
 			return curflow;
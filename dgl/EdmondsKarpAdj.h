@@ -224,6 +224,7 @@ public:
 		return this->maxFlow(source, sink);
 	}
 	const Weight maxFlow(int s, int t) {
+		MONOSAT_TRACE_SPAN("EdmondsKarpAdj::maxFlow", "graph");
 		Weight f = 0;
 #ifdef RECORD
 		if (g.outfile) {
@@ -127,8 +127,10 @@ public:
 	}
 	
 	void update() {
+		MONOSAT_TRACE_SPAN("FloydWarshall::update", "graph");
 		
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("FloydWarshall full update", "graph");
 		
 		if (last_modification > 0 && g.modifications == last_modification) {
 			stats_skipped_updates++;
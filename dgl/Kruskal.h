@@ -115,6 +115,7 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("Kruskal::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 #ifdef RECORD
@@ -128,6 +129,7 @@ public:
 			return;
 		}
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("Kruskal full update", "graph");
 		
 		if (last_deletion == g.deletions) {
 			stats_num_skipable_deletions++;
@@ -412,6 +412,7 @@ private:
 
 public:
 	void update() {
+		MONOSAT_TRACE_SPAN("PKToplogicalSort::update", "graph");
 		static int iteration = 0;
 
 
@@ -126,6 +126,7 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("Prim::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 #ifdef RECORD
@@ -148,6 +149,7 @@ public:
 				INF += w;
 		}
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("Prim full update", "graph");
 		
 		if (last_deletion == g.deletions) {
 			stats_num_skipable_deletions++;
@@ -490,6 +490,7 @@ public:
 	}
 	
 	void update() {
+		MONOSAT_TRACE_SPAN("RamalReps::update", "graph");
 #ifdef RECORD
 		if (g.outfile) {
 			fprintf(g.outfile, "r %d\n", getSource());
@@ -1270,6 +1271,7 @@ public:
 	}
 	
 	void update() {
+		MONOSAT_TRACE_SPAN("UnweightedRamalReps::update", "graph");
 #ifdef RECORD
 		if (g.outfile) {
 			fprintf(g.outfile, "r %d\n", getSource());
@@ -1285,6 +1287,7 @@ public:
 			return;
 		if (last_modification <= 0 || g.changed()) {//Note for the future: there is probably room to improve this further.
 			stats_full_updates++;
+			MONOSAT_TRACE_INSTANT("UnweightedRamalReps full update", "graph");
 			INF = g.nodes() + 1;
 			dist.resize(g.nodes(), INF);
 			dist[getSource()] = 0;
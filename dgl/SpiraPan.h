@@ -603,6 +603,7 @@ public:
 		return num_updates;
 	}
 	void update() {
+		MONOSAT_TRACE_SPAN("SpiraPan::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 #ifdef RECORD
@@ -96,6 +96,7 @@ public:
 	}
 	
 	void update() {
+		MONOSAT_TRACE_SPAN("SteinerApprox::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 #ifdef RECORD
@@ -109,6 +110,7 @@ public:
 			return;
 		}
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("SteinerApprox full update", "graph");
 		
 		if (last_deletion == g.deletions) {
 			stats_num_skipable_deletions++;
@@ -193,6 +193,7 @@ public:
 	}
 	
 	void update() {
+		MONOSAT_TRACE_SPAN("TarjansSCC::update", "graph");
 		static int iteration = 0;
 		int local_it = ++iteration;
 		
@@ -201,6 +202,7 @@ public:
 			return;
 		}
 		stats_full_updates++;
+		MONOSAT_TRACE_INSTANT("TarjansSCC full update", "graph");
 		
 		if (last_deletion == g.deletions) {
 			stats_num_skipable_deletions++;
@@ -0,0 +1,214 @@
+#!/bin/bash
+# Regression tests for MonoSAT's solving modes.
+#
+# Usage: examples/regression/run_tests.sh [path/to/monosat]
+#
+# Every instance (*.cnf, *.gnf) in this directory starts with a few comment lines that say how to check it:
+#   c expect SAT|UNSAT        the expected result (required)
+#   c options <args>          extra command line arguments for monosat
+#   c check drat              also write a DRAT proof, and check it with drat-trim (if UNSAT)
+#   c check snapshot          also write snapshots while solving, and solve again from the last one (-restore)
+#   c check gnf2bin           also convert the instance to binary gnf (-gnf2bin), and solve that
+# The witness of every satisfiable instance is checked against the instance's plain clauses.
+# The features at the end of this script are then tested on some of the instances, by solving them again with the
+# options of each feature.
+# drat-trim is taken from $DRAT_TRIM, or from the PATH; if it is missing, proof checks are skipped.
+#
+# Every session (*.session) is run in -stream mode, and (if python3 is available) sent to a -server, with the options
+# of its 'c options' line; the replies must match those in the corresponding *.replies file. A session with the line
+#   c check reuse-trail       must also keep some decision levels between its solves (see -reuse-trail)
+
+DIR=$(cd "$(dirname "$0")" && pwd)
+MONOSAT=${1:-$DIR/../../Release/monosat}
+DRAT_TRIM=${DRAT_TRIM:-$(command -v drat-trim)}
+PYTHON=$(command -v python3)
+TMP=$(mktemp -d)
+trap 'rm -rf "$TMP"' EXIT
+
+passed=0
+failed=0
+skipped=0
+
+fail() {
+	echo "FAIL $1: $2"
+	failed=$((failed + 1))
+}
+skip() {
+	echo "SKIP $1: $2"
+	skipped=$((skipped + 1))
+}
+
+#Prints the clauses of the instance that are not satisfied by the 'v' lines of the solver output
+check_witness() {
+	awk 'FNR == NR { if ($1 == "v") for (i = 2; i <= NF; i++) model[$i] = 1; next }
+		/^-?[0-9]/ { sat = 0; for (i = 1; i < NF; i++) if ($i in model) sat = 1; if (!sat) print "unsatisfied clause: " $0 }' \
+		"$2" "$1"
+}
+
+#Solve the instance $3 (expecting $1) with the options $4 and after, and check the result, and the witness against
+#the clauses of the text instance $2. Prints what is wrong, if anything.
+solve_and_check() {
+	local expect=$1 text=$2 instance=$3
+	shift 3
+	$MONOSAT -verb=0 -witness "$@" "$instance" > "$TMP/out" 2>&1
+	local result=$(sed -n 's/^s \(SATISFIABLE\|UNSATISFIABLE\)$/\1/p' "$TMP/out" | head -1)
+	case "$expect:$result" in
+	SAT:SATISFIABLE)
+		check_witness "$text" "$TMP/out"
+		;;
+	UNSAT:UNSATISFIABLE)
+		;;
+	*)
+		echo "expected $expect, got '${result:-no result}'"
+		;;
+	esac
+}
+
+for f in "$DIR"/*.gnf "$DIR"/*.cnf; do
+	[ -e "$f" ] || continue
+	name=$(basename "$f")
+	expect=$(sed -n 's/^c expect \(.*\)$/\1/p' "$f" | head -1)
+	options=$(sed -n 's/^c options \(.*\)$/\1/p' "$f" | head -1)
+	checks=$(sed -n 's/^c check \(.*\)$/\1/p' "$f")
+	rm -f "$TMP"/proof.drat* "$TMP/snapshot"
+
+	extra=
+	case "$checks" in *drat*) extra="-proof=$TMP/proof.drat" ;; esac
+	case "$checks" in *snapshot*) extra="$extra -checkpoint=$TMP/snapshot -checkpoint-interval=0.000001" ;; esac
+	bad=$(solve_and_check "$expect" "$f" "$f" $options $extra)
+	if [ -n "$bad" ]; then
+		fail "$name" "$bad"
+		continue
+	fi
+
+	case "$checks" in *drat*)
+		if [ "$expect" != UNSAT ]; then
+			:
+		elif [ -z "$DRAT_TRIM" ]; then
+			skip "$name" "drat-trim not found, proof not checked"
+		elif ! "$DRAT_TRIM" "$TMP/proof.drat.cnf" "$TMP/proof.drat" | grep -q '^s VERIFIED'; then
+			fail "$name" "proof rejected by $DRAT_TRIM"
+			continue
+		fi
+		;;
+	esac
+	case "$checks" in *snapshot*)
+		if [ ! -s "$TMP/snapshot" ]; then
+			fail "$name" "no snapshot was written"
+			continue
+		fi
+		bad=$(solve_and_check "$expect" "$f" "$f" $options -restore="$TMP/snapshot")
+		if [ -n "$bad" ]; then
+			fail "$name" "after restoring: $bad"
+			continue
+		fi
+		;;
+	esac
+	case "$checks" in *gnf2bin*)
+		if ! $MONOSAT -verb=0 -gnf2bin="$TMP/instance.bin" "$f" > /dev/null 2>&1; then
+			fail "$name" "could not convert to binary gnf"
+			continue
+		fi
+		bad=$(solve_and_check "$expect" "$f" "$TMP/instance.bin" $options)
+		if [ -n "$bad" ]; then
+			fail "$name" "binary gnf: $bad"
+			continue
+		fi
+		;;
+	esac
+	passed=$((passed + 1))
+done
+
+#Solve the instance $1 again, with the options $3 and after. If $2 is not empty, the first number of the statistic
+#'$2' (as printed at -verb=2) must not be 0, to show that the instance exercised the feature that the options enable.
+feature() {
+	local name=$1 f=$DIR/$1 stat=$2
+	shift 2
+	local expect=$(sed -n 's/^c expect \(.*\)$/\1/p' "$f" | head -1)
+	local bad=$(solve_and_check "$expect" "$f" "$f" -verb=2 "$@")
+	if [ -z "$bad" ] && [ -n "$stat" ]; then
+		local count=$(sed -n "s/^$stat *: *\([0-9]*\).*$/\1/p" "$TMP/out" | head -1)
+		[ "${count:-0}" -gt 0 ] || bad="no $stat, so the options were not exercised"
+	fi
+	if [ -n "$bad" ]; then
+		fail "$name $*" "$bad"
+	else
+		passed=$((passed + 1))
+	fi
+}
+
+#       instance        statistic               options
+feature php_unsat.cnf   "shared clauses"        -portfolio=4
+feature reach_sat.gnf   "shared clauses"        -portfolio=4
+feature rand_sat.cnf    "chrono backtracks"     -chrono=0
+feature reach_sat.gnf   "chrono backtracks"     -chrono=0
+feature reach_unsat.gnf "chrono backtracks"     -chrono=0
+feature php_unsat.cnf   ""                      -simp-threads=4
+feature rand_sat.cnf    ""                      -simp-threads=4
+feature rand_sat.cnf    "garbage collections"   -gc-young-size=1
+feature php_unsat.cnf   "young promotions"      -gc-young-size=0
+feature reach_sat.gnf   "young promotions"      -gc-young-size=0
+
+#Send the session $1 to a server started with the options $2 and after, printing the replies.
+serve_session() {
+	local session=$1
+	shift
+	: > "$TMP/empty.gnf"
+	$MONOSAT -verb=0 "$@" -server="$TMP/socket" "$TMP/empty.gnf" > /dev/null 2>&1 &
+	local server=$!
+	"$PYTHON" - "$TMP/socket" "$session" <<'EOF'
+import socket, sys, time
+def connect(path):
+	for attempt in range(100):
+		try:
+			s = socket.socket(socket.AF_UNIX)
+			s.connect(path)
+			return s
+		except OSError:
+			time.sleep(0.1)
+	sys.exit("could not connect to the server")
+s = connect(sys.argv[1])
+s.sendall(open(sys.argv[2], "rb").read())
+s.shutdown(socket.SHUT_WR)
+while True:
+	data = s.recv(65536)
+	if not data:
+		break
+	sys.stdout.write(data.decode())
+s.close()
+s = connect(sys.argv[1])
+s.sendall(b"shutdown\n")
+s.close()
+EOF
+	wait $server
+}
+
+for f in "$DIR"/*.session; do
+	[ -e "$f" ] || continue
+	name=$(basename "$f")
+	options=$(sed -n 's/^c options \(.*\)$/\1/p' "$f" | head -1)
+	replies="${f%.session}.replies"
+	checks=$(sed -n 's/^c check \(.*\)$/\1/p' "$f")
+	if ! $MONOSAT -verb=1 $options -stream "$f" 2> "$TMP/stats" | diff - "$replies" > "$TMP/diff"; then
+		fail "$name" "-stream replies differ: $(cat "$TMP/diff")"
+		continue
+	fi
+	case "$checks" in *reuse-trail*)
+		reused=$(sed -n 's/^reused trail levels *: *\([0-9]*\).*$/\1/p' "$TMP/stats")
+		if [ "${reused:-0}" -eq 0 ]; then
+			fail "$name" "no decision levels were reused between solves"
+			continue
+		fi
+		;;
+	esac
+	if [ -z "$PYTHON" ]; then
+		skip "$name" "python3 not found, server mode not tested"
+	elif ! serve_session "$f" $options | diff - "$replies" > "$TMP/diff"; then
+		fail "$name" "-server replies differ: $(cat "$TMP/diff")"
+		continue
+	fi
+	passed=$((passed + 1))
+done
+
+echo "$passed passed, $failed failed, $skipped checks skipped"
+[ "$failed" -eq 0 ]
@@ -220,7 +220,7 @@ void FSMAcceptDetector::buildAcceptReason(int node,int str, vec<Lit> & conflict)
 		printf("%d ",s);
 	}
 	printf("\"\n");*/
-	static vec<NFATransition> path;
+	static thread_local vec<NFATransition> path;
 	path.clear();
 	bool hasPath =underapprox_detector->getPath(str,node,path);
 	assert(hasPath);
@@ -248,8 +248,8 @@ void FSMAcceptDetector::buildNonAcceptReason(int node,int str, vec<Lit> & confli
 	//graph must be unrolled to length of string.
 
 	//instead of actually unrolling the graph, I am going to traverse it backwards, 'unrolling it' implicitly.
-	static vec<int> to_visit;
-	static vec<int> next_visit;
+	static thread_local vec<int> to_visit;
+	static thread_local vec<int> next_visit;
 	vec<int> & string = strings[str];
 /*
 	g_over.draw(source);
@@ -272,8 +272,8 @@ void FSMAcceptDetector::buildNonAcceptReason(int node,int str, vec<Lit> & confli
 	to_visit.clear();
 	next_visit.clear();
 
-	static vec<bool> cur_seen;
-	static vec<bool> next_seen;
+	static thread_local vec<bool> cur_seen;
+	static thread_local vec<bool> next_seen;
 	cur_seen.clear();
 	cur_seen.growTo(g_under.states());
 
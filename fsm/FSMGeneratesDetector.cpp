@@ -216,7 +216,7 @@ void FSMGeneratesDetector::buildGeneratesReason(int str, vec<Lit> & conflict){
 		printf("%d ",s);
 	}
 	printf("\"\n");*/
-	static vec<NFATransition> path;
+	static thread_local vec<NFATransition> path;
 	path.clear();
 	bool hasPath =underapprox_detector->getPath(str,path);
 	assert(hasPath);
@@ -324,7 +324,7 @@ void FSMGeneratesDetector::buildNonGeneratesReason(int str, vec<Lit> & conflict)
 	if(++iter==10189){
 		int a=1;
 	}
-	static vec<NFATransition> ignore;
+	static thread_local vec<NFATransition> ignore;
 	ignore.clear();
 	unique_path_conflict(source, str, 0,0,ignore,conflict);
 
@@ -334,8 +334,8 @@ void FSMGeneratesDetector::printSolution(std::ostream& out){
 
 
 
-	static vec<NFATransition> ignore;
-	static vec<Lit> ignore_conf;
+	static thread_local vec<NFATransition> ignore;
+	static thread_local vec<Lit> ignore_conf;
 	for(int str = 0;str<strings.size();str++){
 		ignore.clear();
 		ignore_conf.clear();
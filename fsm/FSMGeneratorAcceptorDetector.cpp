@@ -384,7 +384,7 @@ bool FSMGeneratorAcceptorDetector::propagate(vec<Lit> & conflict) {
 	if (++iter == 87) {
 		int a = 1;
 	}
-	static vec<ForcedTransition> forced_edges;
+	static thread_local vec<ForcedTransition> forced_edges;
 
 	for(auto & t:all_accept_lits){
 			forced_edges.clear();
@@ -504,7 +504,7 @@ void FSMGeneratorAcceptorDetector::buildAcceptReason(int genFinal, int acceptFin
 	++iter;
 //find a path - ideally, the one that traverses the fewest unique transitions - from source to node, learn that one of the transitions on that path must be disabled.
 	if(!opt_fsm_negate_underapprox){
-		static vec<NFATransition> path;
+		static thread_local vec<NFATransition> path;
 		path.clear();
 		underapprox_detector->getGeneratorPath(genFinal,acceptFinal,path);
 
@@ -519,14 +519,14 @@ void FSMGeneratorAcceptorDetector::buildAcceptReason(int genFinal, int acceptFin
 			conflict.push(mkLit(v,true));
 		}
 	}else{
-		static vec<ForcedTransition> forced_edges;
+		static thread_local vec<ForcedTransition> forced_edges;
 		forced_edges.clear();
 		assert(!overapprox_detector->accepts(genFinal,acceptFinal,true,&forced_edges));
 		assert( !overapprox_detector->accepts(genFinal,acceptFinal,true));
 		//run an NFA to find all transitions that accepting prefixes use.
 		//printf("conflict %d\n",iter);
 		//g_over.draw(gen_source,genFinal);
-		static vec<NFATransition> path;
+		static thread_local vec<NFATransition> path;
 		path.clear();
 		overapprox_detector->getGeneratorPath(genFinal,acceptFinal,path,false,true);
 
@@ -794,7 +794,7 @@ void FSMGeneratorAcceptorDetector::buildForcedEdgeReason(int genFinal, int accep
 		exit(1);
 	}else{
 
-		static vec<NFATransition> path;
+		static thread_local vec<NFATransition> path;
 		path.clear();
 		find_gen_path(genFinal,acceptFinal,forcedEdge,forcedLabel,path,false,true);
 
@@ -818,7 +818,7 @@ void FSMGeneratorAcceptorDetector::buildForcedEdgeReason(int genFinal, int accep
 
 void FSMGeneratorAcceptorDetector::buildNonAcceptReason(int genFinal, int acceptFinal, vec<Lit> & conflict){
 
-	static vec<NFATransition> path;
+	static thread_local vec<NFATransition> path;
 	path.clear();
 
 	assert( !overapprox_detector->accepts(genFinal,acceptFinal,false));
@@ -827,7 +827,7 @@ void FSMGeneratorAcceptorDetector::buildNonAcceptReason(int genFinal, int accept
 	//g_over.draw(gen_source,genFinal);
 	//acceptor_over.draw(accept_source,acceptFinal);
 	overapprox_detector->getGeneratorPath(genFinal,acceptFinal,path,true,true);
-	static vec<bool> seen_states;
+	static thread_local vec<bool> seen_states;
 	/*seen_states.clear();
 	seen_states.growTo(g_over.states());
 	if(true||g_over.mustBeDeterministic()){
@@ -1203,7 +1203,7 @@ Lit FSMGeneratorAcceptorDetector::decide(int level) {
 		if(outer->value(l)==l_False){
 			int gen_to = t.gen_to;
 			int accept_to = t.accept_to;
-			static vec<NFATransition> path;
+			static thread_local vec<NFATransition> path;
 			path.clear();
 
 			if(overapprox_detector->getGeneratorPath(gen_to,accept_to,path,true,false)){
@@ -1236,7 +1236,7 @@ void FSMGeneratorAcceptorDetector::printSolution(std::ostream& out){
 		int accept_to = t.accept_to;
 
 		if(outer->value(l)==l_True){
-			static vec<NFATransition> path;
+			static thread_local vec<NFATransition> path;
 			path.clear();
 			assert(underapprox_detector->accepts(gen_to,accept_to));
 			underapprox_detector->getGeneratorPath(gen_to,accept_to,path);
@@ -1251,7 +1251,7 @@ void FSMGeneratorAcceptorDetector::printSolution(std::ostream& out){
 			}
 			out<<"\n";
 		}else{
-			static vec<NFATransition> path;
+			static thread_local vec<NFATransition> path;
 			path.clear();
 			if(g_under.generates(gen_source,gen_to, path)){
 				out<<"Generated string: ";
@@ -535,12 +535,15 @@ public:
 		
 	}
 	
+	bool supportsChronologicalBacktracking() {
+		return true;
+	}
 	void enqueueTheory(Lit l) {
 		Var v = var(l);
 		
 		int lev = level(v);
 		
-		assert(decisionLevel() <= lev);
+		assert(decisionLevel() <= lev || opt_chrono_backtrack >= 0);
 		
 		while (lev > trail_lim.size()) {
 			newDecisionLevel();
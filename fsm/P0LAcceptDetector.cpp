@@ -173,7 +173,7 @@ void P0LAcceptDetector::buildReason(Lit p, vec<Lit> & reason, CRef marker) {
 
 void P0LAcceptDetector::buildAcceptReason(int atom,int str, vec<Lit> & conflict){
 	//the reason the string was accepted is simply the set of all unique ruleIDs that were traversed accepting the string.
-	static vec<int> store_edges;
+	static thread_local vec<int> store_edges;
 	store_edges.clear();
 	bool r = underapprox_detector->getUsedRules(str,store_edges);
 	assert(r);
@@ -498,8 +498,8 @@ bool P0LAcceptDetector::accepts_rec(int atom,int str,int depth,vec<int> * blocki
 }
 
 void P0LAcceptDetector::analyzeNFT(int atom,int source, int final,vec<int> & string,vec<int> & blocking,vec<Bitset> & suffixTable){
-		static vec<int> to_visit;
-		static vec<int> next_visit;
+		static thread_local vec<int> to_visit;
+		static thread_local vec<int> next_visit;
 
 		//explain why this transducer only produces the set of strings it produces, and not others, given this string as input.
 		//build FULL, level-0 overapprox suffix table to filter the dfs exploration below.
@@ -511,8 +511,8 @@ void P0LAcceptDetector::analyzeNFT(int atom,int source, int final,vec<int> & str
 		to_visit.clear();
 		next_visit.clear();
 
-		static vec<bool> cur_seen;
-		static vec<bool> next_seen;
+		static thread_local vec<bool> cur_seen;
+		static thread_local vec<bool> next_seen;
 		cur_seen.clear();
 		cur_seen.growTo(acceptor.states());
 
@@ -745,7 +745,7 @@ void P0LAcceptDetector::updateAcceptor(){
 }
 
 void P0LAcceptDetector::buildNonAcceptReason(int atom,int str, vec<Lit> & conflict){
-	static vec<int> store_edges;
+	static thread_local vec<int> store_edges;
 	store_edges.clear();
 
 	updateAcceptor();
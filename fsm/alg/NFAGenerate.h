@@ -198,7 +198,7 @@ public:
 
 	//inefficient!
 	bool generatesString(int string){
-		static vec<NFATransition> ignore;
+		static thread_local vec<NFATransition> ignore;
 		ignore.clear();
 		return getPath(string, ignore);
 	}
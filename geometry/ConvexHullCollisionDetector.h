@@ -480,8 +480,8 @@ void ConvexHullCollisionDetector<D, T>::buildCollisionReason2d(vec<Lit> & confli
 	assert(h1.intersects(h2, inclusive));
 	assert(h2.intersects(h1, inclusive));
 	
-	static NConvexPolygon<2, T> intersect1;
-	static NConvexPolygon<2, T> intersect2;
+	static thread_local NConvexPolygon<2, T> intersect1;
+	static thread_local NConvexPolygon<2, T> intersect2;
 	intersect1.clear();
 	intersect2.clear();
 	bool check = h1.intersects(h2, &intersect1, &intersect2, inclusive);
@@ -525,7 +525,7 @@ void ConvexHullCollisionDetector<D, T>::buildCollisionReason2d(vec<Lit> & confli
 
 	 for(int i = 0; i<h1.size();i++){
 	 if(h2.contains(h1[i],inclusive)){
-	 static NConvexPolygon<2,T> triangle;
+	 static thread_local NConvexPolygon<2,T> triangle;
 	 triangle.clear();
 	 //findContainingTriangle2d(h2,h1[i],triangle,inclusive);
 	 h2.contains(h1[i],&triangle,inclusive);
@@ -542,7 +542,7 @@ void ConvexHullCollisionDetector<D, T>::buildCollisionReason2d(vec<Lit> & confli
 
 	 for(int i = 0; i<h2.size();i++){
 	 if(h1.contains(h2[i],inclusive)){
-	 static NConvexPolygon<2,T> triangle;
+	 static thread_local NConvexPolygon<2,T> triangle;
 	 triangle.clear();
 	 //findContainingTriangle2d(h1,h2[i],triangle,inclusive);
 	 h1.contains(h2[i],&triangle,inclusive);
@@ -1286,9 +1286,9 @@ void ConvexHullDetector<D, T>::buildConvexNotIntersectsReason2d(ConvexPolygon<2,
 	//or some disabled point in h2 that is to the left of the leftmost point in h2 must be enabled.
 	
 	//Note: It may be possible to improve on this analysis!
-	static std::vector<std::pair<Point<2, T>, T>> projection;
+	static thread_local std::vector<std::pair<Point<2, T>, T>> projection;
 	projection.clear();
-	static std::vector<std::pair<Point<2, T>, T>> projection2;
+	static thread_local std::vector<std::pair<Point<2, T>, T>> projection2;
 	projection2.clear();
 	bool found = findSeparatingAxis2d(h1, h2, over, projection, projection2, inclusive);
 	assert(found);
@@ -1390,7 +1390,7 @@ void ConvexHullDetector<D, T>::buildConvexIntersectsReason2d(ConvexPolygon<2, T>
 	//(since cases 1 and 2 overlap, we have to make a choice about which to favour...)
 	assert(h1.intersects(h2, inclusive));
 	assert(h2.intersects(h1, inclusive));
-	static NConvexPolygon<2, T> intersect1;
+	static thread_local NConvexPolygon<2, T> intersect1;
 	
 	intersect1.clear();
 	
@@ -1428,7 +1428,7 @@ void ConvexHullDetector<D, T>::buildConvexIntersectsReason2d(ConvexPolygon<2, T>
 
 	 for(int i = 0; i<h1.size();i++){
 	 if(h2.contains(h1[i],inclusive)){
-	 static NConvexPolygon<2,T> triangle;
+	 static thread_local NConvexPolygon<2,T> triangle;
 	 h2.contains(h1[i],&triangle,inclusive);
 	 //findContainingTriangle2d(h2,h1[i],triangle,inclusive);
 	 assert(triangle.contains(h1[i],inclusive));
@@ -1439,7 +1439,7 @@ void ConvexHullDetector<D, T>::buildConvexIntersectsReason2d(ConvexPolygon<2, T>
 
 	 for(int i = 0; i<h2.size();i++){
 	 if(h1.contains(h2[i],inclusive)){
-	 static NConvexPolygon<2,T> triangle;
+	 static thread_local NConvexPolygon<2,T> triangle;
 	 h1.contains(h2[i],&triangle,inclusive);
 	 //findContainingTriangle2d(h1,h2[i],triangle,inclusive);
 	 assert(triangle.contains(h2[i],inclusive));
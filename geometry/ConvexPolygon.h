@@ -429,7 +429,7 @@ bool ConvexPolygon<D, T>::containsInSplit(const Point<D, T> & point, int firstVe
 		bool excludeVertices) {
 	this->update();
 	if (D == 2) {
-		static NConvexPolygon<2, T> ignore;
+		static thread_local NConvexPolygon<2, T> ignore;
 		return containsInSplit2d((const Point<2, T> &) point, firstVertex, lastVertex, ignore, inclusive,
 				excludeVertices);
 	} else {
@@ -897,7 +897,7 @@ bool ConvexPolygon<D, T>::edgesIntersectLine2d(LineSegment<2, T> & check, NConve
 	}
 	if (out)
 		out->clear();
-	static LineSegment<2, T> test;
+	static thread_local LineSegment<2, T> test;
 	bool seenContainedLine = false;
 	for (int i = 0; i < w.size(); i++) {
 		Point<2, T> & prev = i > 0 ? w[i - 1] : w.back();
@@ -947,7 +947,7 @@ bool ConvexPolygon<D, T>::edgesIntersectLine2d(LineSegment<2, T> & check, NConve
  return false;
  return line.contains((*this)[0],inclusive);
  }
- static NConvexPolygon<2,T>  ignore;
+ static thread_local NConvexPolygon<2,T>  ignore;
  //the line may still intersect even if neither end point is contained.
  //we could apply the SAT here. But instead, we're going to walk around the edges of the convex shape, and see if any of the edges intersect this line.
  return edgesIntersectLine2d(line,ignore, inclusive);
@@ -1640,7 +1640,7 @@ bool ConvexPolygon<D, T>::intersects2d(Shape<2, T> & shape, NConvexPolygon<2, T>
 						 //now find two vertices of h2 that form a line that intersects this one. the vertices will come from separate sides of h2.
 						 if(polygon_out_2){
 						 polygon_out_2->clear();
-						 static LineSegment<2,T> line1;
+						 static thread_local LineSegment<2,T> line1;
 
 						 line1.a = hull1[i-1];
 						 line1.b = hull1[i];
@@ -1670,7 +1670,7 @@ bool ConvexPolygon<D, T>::intersects2d(Shape<2, T> & shape, NConvexPolygon<2, T>
 						 //cross the cleaving line exactly at an endpoint.
 						 //in that case, if the collision is not inclusive, then we can resolve this by finding any point from h2 that is not collinear with that line.
 						 if(!inclusive && !line1.intersects(*polygon_out_2,false)){
-						 static LineSegment<2,T> line2;
+						 static thread_local LineSegment<2,T> line2;
 						 line2.a = (*polygon_out_2)[0];
 						 line2.b = (*polygon_out_2)[1];
 						 assert(hull2.dbg_orderClockwise());
@@ -1829,14 +1829,14 @@ void NConvexPolygon<D, T>::reorderVertices2d() {
 		}
 	};
 	//this should ideally be avoided...
-	static std::vector<int> points_clockwise;
+	static thread_local std::vector<int> points_clockwise;
 	points_clockwise.clear();
 	for (int i = 0; i < vertices.size(); i++) {
 		points_clockwise.push_back(i);
 	}
 	std::sort(points_clockwise.begin(), points_clockwise.end(), clockwise_lt(vertices, centerX, centerY));
 	//do this in place later
-	static std::vector<Point<2, T>> oldPoints;
+	static thread_local std::vector<Point<2, T>> oldPoints;
 	oldPoints.clear();
 	for (int i = 0; i < vertices.size(); i++) {
 		oldPoints.push_back(vertices[i]);
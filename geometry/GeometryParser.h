@@ -280,6 +280,11 @@ public:
 		return true;
 	}
 	
+	//('implementConstraints()' adds all of the points parsed so far each time it is called)
+	bool supportsIncrementalInput() const {
+		return false;
+	}
+
 	void implementConstraints(Solver & S) {
 		//build point sets in their appropriate spaces.
 		//for now, we only support up to 3 dimensions
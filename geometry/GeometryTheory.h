@@ -350,7 +350,7 @@ public:
 	
 	bool dbg_propgation(Lit l) {
 #ifndef NDEBUG
-		static vec<Lit> c;
+		static thread_local vec<Lit> c;
 		c.clear();
 		for (int i = 0; i < S->trail.size(); i++) {
 			if (!S->hasTheory(S->trail[i]) || S->getTheoryID(S->trail[i]) != getTheoryIndex())
@@ -593,12 +593,15 @@ public:
 			d->printSolution();
 		}
 	}
+	bool supportsChronologicalBacktracking() {
+		return true;
+	}
 	void enqueueTheory(Lit l) {
 		Var v = var(l);
 		assert(S->value(toSolver(l))==l_True);
 		int lev = level(v);
 		
-		assert(decisionLevel() <= lev);
+		assert(decisionLevel() <= lev || opt_chrono_backtrack >= 0);
 		
 		while (lev > trail_lim.size()) {
 			newDecisionLevel();
@@ -697,7 +700,7 @@ public:
 		
 		bool any_change = false;
 		double startproptime = rtime(1);
-		static vec<int> detectors_to_check;
+		static thread_local vec<int> detectors_to_check;
 		
 		conflict.clear();
 		
@@ -669,14 +669,14 @@ void NPolygon<D, T>::reorderVertices2d() {
 		}
 	};
 	//this should ideally be avoided...
-	static std::vector<int> points_clockwise;
+	static thread_local std::vector<int> points_clockwise;
 	points_clockwise.clear();
 	for (int i = 0; i < vertices.size(); i++) {
 		points_clockwise.push_back(i);
 	}
 	std::sort(points_clockwise.begin(), points_clockwise.end(), clockwise_lt(vertices, centerX, centerY));
 	//do this in place later
-	static std::vector<Point<2, T>> oldPoints;
+	static thread_local std::vector<Point<2, T>> oldPoints;
 	oldPoints.clear();
 	assert(vertices.size() > 0);
 	
@@ -25,6 +25,7 @@
 #include "GraphTheoryTypes.h"
 #include "mtl/Vec.h"
 #include "core/Config.h"
+#include "core/Profile.h"
 #include <cstdio>
 #include <iostream>
 namespace Monosat {
@@ -60,6 +61,16 @@ public:
 	int getID() {
 		return detectorID;
 	}
+#ifdef MONOSAT_PROFILE
+	Profiler::Site * profile_site = nullptr;
+	//Where to record the time spent in this detector (registered on first use; see core/Profile.h).
+	Profiler::Site * profileSite(int graphID) {
+		if (!profile_site)
+			profile_site = Profiler::addSite(
+					"graph " + std::to_string(graphID) + " detector " + std::to_string(detectorID) + " (" + getName() + ")");
+		return profile_site;
+	}
+#endif
 	
 	virtual const char* getName() {
 		return "<unknown>";
@@ -118,6 +129,10 @@ public:
 	virtual void suggestDecision(Lit l){
 		//do nothing
 	}
+	//Suggest phases for edge literals (in the theory's variable space), e.g. the edges of a witness for an asserted property.
+	virtual void addPhaseHints(vec<Lit> & hints){
+		//do nothing
+	}
 	virtual void setOccurs(Lit l, bool occurs) {
 		if (!occurs) {
 			if (sign(l))
@@ -137,6 +137,16 @@ class GraphParser: public Parser<B, Solver> {
 	vec<MaxFlow<double>> maxflows_float;
 	vec<MaxFlow<mpq_class>> maxflows_rational;
 
+	vec<uint64_t> graph_solves; //for each graph, the number of solves before it was declared
+
+	//Edges can only be added to a graph until it is first solved, as the lemmas that are learnt from a graph
+	//(and kept between solves) only hold for the edges that it had at the time.
+	void checkUnsolved(int graphID, Var edgeVar, Solver& S) {
+		if (graph_solves[graphID] != S.solves) {
+			parseError(1, "Edge %d added to graph %d after it was solved", edgeVar + 1, graphID);
+		}
+	}
+
 	void readDiGraph(B& in, GraphType graph_type, Solver& S) {
 		if (opt_ignore_theories) {
 			skipLine(in);
@@ -152,17 +162,16 @@ class GraphParser: public Parser<B, Solver> {
 		int g, n, e, ev;
 		
 		n = parseInt(in); //num nodes
-		e = parseInt(in); //num edges (I'm ignoring this currently)
+		e = parseInt(in); //num edges (only used to preallocate the edges of integer graphs)
 		//  ev = parseInt(in);//the variable of the first graph edge.
 		g = parseInt(in);  //id of the graph
 		graphs.growTo(g + 1);
 		graphs_float.growTo(g + 1);
 		graphs_rational.growTo(g + 1);
+		graph_solves.growTo(g + 1);
+		graph_solves[g] = S.solves;
 		if (graph_type == GraphType::INTEGER) {
-			GraphTheorySolver<long> *graph = new GraphTheorySolver<long>(&S);
-			graph->newNodes(n);
-			graphs[g] = graph;
-			S.addTheory(graph);
+			newGraph(g, n, S, e);
 		} else if (graph_type == GraphType::FLOAT) {
 			GraphTheorySolver<double> *graph = new GraphTheorySolver<double>(&S);
 			graph->newNodes(n);
@@ -189,10 +198,10 @@ class GraphParser: public Parser<B, Solver> {
 		int priority = parseInt(in);
 
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, edgeVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, edgeVar);
 		}
 		if (edgeVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", edgeVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", edgeVar);
 		}
 
 		edgePriorities.push({graphID, edgeVar,priority});
@@ -204,8 +213,7 @@ class GraphParser: public Parser<B, Solver> {
 		} else if (graphs_rational[graphID]) {
 
 		} else {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, edgeVar), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, edgeVar);
 		}
 	}
 	void readEdgeBV(B& in, Solver& S) {
@@ -222,11 +230,12 @@ class GraphParser: public Parser<B, Solver> {
 		int edgeVar = parseInt(in) - 1;
 
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, edgeVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, edgeVar);
 		}
 		if (edgeVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", edgeVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", edgeVar);
 		}
+		checkUnsolved(graphID, edgeVar, S);
 		while (edgeVar >= S.nVars())
 			S.newVar();
 
@@ -249,8 +258,7 @@ class GraphParser: public Parser<B, Solver> {
 		} else if (graphs_rational[graphID]) {
 			graphs_rational[graphID]->newEdge(from, to, edgeVar,bvID);
 		} */else {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, edgeVar), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, edgeVar);
 		}
 	}
 	
@@ -268,11 +276,12 @@ class GraphParser: public Parser<B, Solver> {
 		int edgeVar = parseInt(in) - 1;
 		
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, edgeVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, edgeVar);
 		}
 		if (edgeVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", edgeVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", edgeVar);
 		}
+		checkUnsolved(graphID, edgeVar, S);
 		while (edgeVar >= S.nVars())
 			S.newVar();
 		
@@ -287,14 +296,13 @@ class GraphParser: public Parser<B, Solver> {
 			} else if (graphs_rational[graphID]) {
 				graphs_rational[graphID]->newEdge(from, to, edgeVar);
 			} else {
-				printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, edgeVar), exit(1);
-				exit(1);
+				parseError(1, "Undeclared graph identifier %d for edge %d", graphID, edgeVar);
 			}
 			
 		}else{
 
 			if (graphs[graphID]) {
-				int weight = parseInt(in);
+				long weight = parseLong(in);
 				graphs[graphID]->newEdge(from, to, edgeVar, weight);
 			} else if (graphs_float[graphID]) {
 				//float can be either a plain integer, or a rational in the form '123/456', or a floating point in decimal format
@@ -330,8 +338,7 @@ class GraphParser: public Parser<B, Solver> {
 				}
 
 			} else {
-				printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, edgeVar), exit(1);
-				exit(1);
+				parseError(1, "Undeclared graph identifier %d for edge %d", graphID, edgeVar);
 			}
 		}
 	}
@@ -350,26 +357,7 @@ class GraphParser: public Parser<B, Solver> {
 		// int steps = parseInt(in);
 		int to = parseInt(in);
 		int reachVar = parseInt(in) - 1;
-		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
-		}
-		if (reachVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
-		}
-		
-		while (reachVar >= S.nVars())
-			S.newVar();
-		
-		if (graphs[graphID]) {
-			graphs[graphID]->reaches(from, to, reachVar);
-		} else if (graphs_float[graphID]) {
-			graphs_float[graphID]->reaches(from, to, reachVar);
-		} else if (graphs_rational[graphID]) {
-			graphs_rational[graphID]->reaches(from, to, reachVar);
-		} else {
-			printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-			exit(1);
-		}
+		newReach(graphID, from, to, reachVar, S);
 	}
 	
 	void readDistance(B& in, Solver& S, bool leq = false) {
@@ -387,10 +375,10 @@ class GraphParser: public Parser<B, Solver> {
 		int reachVar = parseInt(in) - 1;
 		int steps = parseInt(in);
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 		}
 		if (reachVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", reachVar);
 		}
 		
 		if (graphs[graphID]) {
@@ -400,8 +388,7 @@ class GraphParser: public Parser<B, Solver> {
 		} else if (graphs_rational[graphID]) {
 			graphs_rational[graphID]->reaches(from, to, reachVar, steps);
 		} else {
-			printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d", graphID);
 		}
 	}
 
@@ -420,10 +407,10 @@ class GraphParser: public Parser<B, Solver> {
 		int reachVar = parseInt(in) - 1;
 
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 		}
 		if (reachVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", reachVar);
 		}
 
 		skipWhitespace(in);
@@ -436,8 +423,7 @@ class GraphParser: public Parser<B, Solver> {
 		} else if (graphs_rational[graphID]) {
 			graphs_rational[graphID]->newEdge(from, to, edgeVar,bvID);
 		} */else {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 		}
 
 	}
@@ -457,15 +443,15 @@ class GraphParser: public Parser<B, Solver> {
 		int reachVar = parseInt(in) - 1;
 
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 		}
 		if (reachVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", reachVar);
 		}
 
 
 		if (graphs[graphID]) {
-			int weight = parseInt(in);
+			long weight = parseLong(in);
 			distances_long.push({graphID,from,to,reachVar,!leq,weight});
 			//graphs[graphID]->distance(from, to, reachVar, weight);
 		} else if (graphs_float[graphID]) {
@@ -502,8 +488,7 @@ class GraphParser: public Parser<B, Solver> {
 			}
 
 		} else {
-			printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d", graphID);
 		}
 	}
 
@@ -520,10 +505,10 @@ class GraphParser: public Parser<B, Solver> {
 			int reachVar = parseInt(in) - 1;
 
 			if (graphID < 0 || graphID >= graphs.size()) {
-				printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+				parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 			}
 			if (reachVar < 0) {
-				printf("PARSE ERROR! Variables must be >=0, was %d\n", reachVar), exit(1);
+				parseError(1, "Variables must be >=0, was %d", reachVar);
 			}
 			if (graphs[graphID]) {
 				graphs[graphID]->acyclic(reachVar,directed);
@@ -532,8 +517,7 @@ class GraphParser: public Parser<B, Solver> {
 			} else if (graphs_rational[graphID]) {
 				graphs_rational[graphID]->acyclic(reachVar,directed);
 			} else {
-				printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-				exit(1);
+				parseError(1, "Undeclared graph identifier %d", graphID);
 			}
 		}
 
@@ -551,16 +535,16 @@ class GraphParser: public Parser<B, Solver> {
 
 
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 		}
 		if (reachVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", reachVar);
 		}
 		
 		while (reachVar >= S.nVars())
 			S.newVar();
 		if (graphs[graphID]) {
-			long maxweight = parseInt(in);
+			long maxweight = parseLong(in);
 			graphs[graphID]->minimumSpanningTree(reachVar, maxweight,inclusive);
 		} else if (graphs_float[graphID]) {
 			//float can be either a plain integer, or a rational (interpreted at floating point precision) in the form '123/456', or a floating point in decimal format
@@ -596,8 +580,7 @@ class GraphParser: public Parser<B, Solver> {
 			}
 
 		} else {
-			printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d", graphID);
 		}
 
 	}
@@ -617,10 +600,10 @@ class GraphParser: public Parser<B, Solver> {
 		//int to = parseInt(in);
 		int reachVar = parseInt(in) - 1;
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 		}
 		if (reachVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", reachVar);
 		}
 		
 		while (reachVar >= S.nVars())
@@ -633,8 +616,7 @@ class GraphParser: public Parser<B, Solver> {
 		} else if (graphs_rational[graphID]) {
 			graphs_rational[graphID]->edgeInMinimumSpanningTree(edgeVar, reachVar);
 		} else {
-			printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d", graphID);
 		}
 	}
 
@@ -654,10 +636,10 @@ class GraphParser: public Parser<B, Solver> {
 
 
 			if (graphID < 0 || graphID >= graphs.size()) {
-				printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+				parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 			}
 			if (reachVar < 0) {
-				printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+				parseError(1, "Edge variables must be >=0, was %d", reachVar);
 			}
 
 			while (reachVar >= S.nVars())
@@ -679,15 +661,15 @@ class GraphParser: public Parser<B, Solver> {
 			int graphID = parseInt(in);
 			int s = parseInt(in);
 			int t = parseInt(in);
-			long flow = parseInt(in); //old maxflow constraints always compared to an int
+			long flow = parseLong(in); //old maxflow constraints always compared to an int
 			int reachVar = parseInt(in) - 1; //note: maximum flow constraint format has been changed since the paper. The order of reachVar and flow after the paper, to allow for non-integer flow constraints.
 			bool inclusive=true;//old maxflow constraints were always inclusive.
 
 			if (graphID < 0 || graphID >= graphs.size()) {
-				printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+				parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 			}
 			if (reachVar < 0) {
-				printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+				parseError(1, "Edge variables must be >=0, was %d", reachVar);
 			}
 
 			while (reachVar >= S.nVars())
@@ -700,8 +682,7 @@ class GraphParser: public Parser<B, Solver> {
 			} else if (graphs_rational[graphID]) {
 				maxflows_rational.push({graphID,s,t,reachVar,!inclusive,(mpq_class)flow});
 			} else {
-				printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-				exit(1);
+				parseError(1, "Undeclared graph identifier %d", graphID);
 			}
 		}
 	void readMaxFlowConstraint(B& in, Solver& S, bool inclusive) {
@@ -719,10 +700,10 @@ class GraphParser: public Parser<B, Solver> {
 
 
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 		}
 		if (reachVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", reachVar);
 		}
 
 		while (reachVar >= S.nVars())
@@ -731,7 +712,7 @@ class GraphParser: public Parser<B, Solver> {
 		//parse the flow constraint appropriately for the type of the graph:
 
 		if (graphs[graphID]) {
-			long flow = parseInt(in);
+			long flow = parseLong(in);
 
 			maxflows_long.push({graphID,s,t,reachVar,!inclusive,flow});
 			//graphs[graphID]->maxFlow(s, t, flow, reachVar,inclusive);
@@ -772,8 +753,7 @@ class GraphParser: public Parser<B, Solver> {
 			}
 
 		} else {
-			printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d", graphID);
 		}
 
 	}
@@ -791,10 +771,10 @@ class GraphParser: public Parser<B, Solver> {
 		int min_components = parseInt(in);
 		int reachVar = parseInt(in) - 1;
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d for edge %d\n", graphID, reachVar), exit(1);
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
 		}
 		if (reachVar < 0) {
-			printf("PARSE ERROR! Edge variables must be >=0, was %d\n", reachVar), exit(1);
+			parseError(1, "Edge variables must be >=0, was %d", reachVar);
 		}
 		
 		while (reachVar >= S.nVars())
@@ -807,8 +787,7 @@ class GraphParser: public Parser<B, Solver> {
 		} else if (graphs_rational[graphID]) {
 			graphs_rational[graphID]->minConnectedComponents(min_components, reachVar);
 		} else {
-			printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-			exit(1);
+			parseError(1, "Undeclared graph identifier %d", graphID);
 		}
 	}
 	
@@ -851,7 +830,7 @@ class GraphParser: public Parser<B, Solver> {
 		int node = parseInt(in);
 		int var = parseInt(in) - 1;
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d \n", graphID), exit(1);
+			parseError(1, "Undeclared graph identifier %d ", graphID);
 		}
 		steiners.growTo(graphs.size());
 		steiners[graphID].growTo(steinerID + 1);
@@ -873,7 +852,7 @@ class GraphParser: public Parser<B, Solver> {
 		int maxweight = parseInt(in);
 		int var = parseInt(in) - 1;
 		if (graphID < 0 || graphID >= graphs.size()) {
-			printf("PARSE ERROR! Undeclared graph identifier %d \n", graphID), exit(1);
+			parseError(1, "Undeclared graph identifier %d ", graphID);
 		}
 		steiners.growTo(graphs.size());
 		steiners[graphID].growTo(steinerID + 1);
@@ -914,7 +893,7 @@ class GraphParser: public Parser<B, Solver> {
 		weights.clear();
 		int size = parseInt(in);
 		if (size <= 0) {
-			printf("PARSE ERROR! Empty PB clause\n"), exit(1);
+			parseError(1, "Empty PB clause");
 		}
 		
 		for (int i = 0; i < size; i++) {
@@ -929,7 +908,7 @@ class GraphParser: public Parser<B, Solver> {
 		
 		int wsize = parseInt(in);
 		if (wsize != 0 && wsize != size) {
-			printf("PARSE ERROR! Number of weights must either be the same as the size of the clause, or 0.\n"), exit(1);
+			parseError(1, "Number of weights must either be the same as the size of the clause, or 0.");
 		}
 		for (int i = 0; i < wsize; i++) {
 			int parsed_weight = parseInt(in);
@@ -961,7 +940,7 @@ class GraphParser: public Parser<B, Solver> {
 		} else if (*in == '!') {
 			++in;
 			if (*in != '=') {
-				printf("PARSE ERROR! Unexpected char: %c\n", *in), exit(1);
+				parseError(1, "Unexpected char: %c", *in);
 			}
 			++in;
 			op = PbTheory::PbType::NE;
@@ -969,7 +948,7 @@ class GraphParser: public Parser<B, Solver> {
 			++in;
 			op = PbTheory::PbType::EQ;
 		}else{
-			printf("PARSE ERROR! Bad PB constraint\n"), exit(1);
+			parseError(1, "Bad PB constraint");
 		}
 		int comparison = parseInt(in);
 		int type = parseInt(in);
@@ -997,8 +976,67 @@ class GraphParser: public Parser<B, Solver> {
 public:
 	GraphParser(bool precise, BVTheorySolver<long>*& bvTheory) :
 			precise(precise),bvTheory(bvTheory) {
-		
+
+	}
+
+	//Declare the integer weighted graph 'g', with n nodes and (expected) 'edges' edges
+	//(also used to load binary gnf, see 'Dimacs::parse_binary()').
+	void newGraph(int g, int n, Solver& S, int edges = 0) {
+		if (opt_ignore_theories)
+			return;
+		graphs.growTo(g + 1);
+		graphs_float.growTo(g + 1);
+		graphs_rational.growTo(g + 1);
+		graph_solves.growTo(g + 1);
+		graph_solves[g] = S.solves;
+		GraphTheorySolver<long> *graph = new GraphTheorySolver<long>(&S);
+		graph->newNodes(n);
+		graph->reserveEdges(std::min(edges, 1 << 24)); //(don't trust implausibly large edge counts)
+		graphs[g] = graph;
+		S.addTheory(graph);
+	}
+
+	//Add an edge to the integer weighted graph 'graphID' (for binary gnf).
+	void newEdge(int graphID, int from, int to, Var edgeVar, int weight, Solver& S) {
+		if (opt_ignore_theories)
+			return;
+		if (graphID < 0 || graphID >= graphs.size() || !graphs[graphID]) {
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, edgeVar);
+		}
+		if (edgeVar < 0) {
+			parseError(1, "Edge variables must be >=0, was %d", edgeVar);
+		}
+		checkUnsolved(graphID, edgeVar, S);
+		while (edgeVar >= S.nVars())
+			S.newVar();
+		graphs[graphID]->newEdge(from, to, edgeVar, weight);
 	}
+
+	//Add the atom reachVar, which is true iff 'to' is reachable from 'from' in graph 'graphID'.
+	void newReach(int graphID, int from, int to, Var reachVar, Solver& S) {
+		if (opt_ignore_theories)
+			return;
+		if (graphID < 0 || graphID >= graphs.size()) {
+			parseError(1, "Undeclared graph identifier %d for edge %d", graphID, reachVar);
+		}
+		if (reachVar < 0) {
+			parseError(1, "Edge variables must be >=0, was %d", reachVar);
+		}
+
+		while (reachVar >= S.nVars())
+			S.newVar();
+
+		if (graphs[graphID]) {
+			graphs[graphID]->reaches(from, to, reachVar);
+		} else if (graphs_float[graphID]) {
+			graphs_float[graphID]->reaches(from, to, reachVar);
+		} else if (graphs_rational[graphID]) {
+			graphs_rational[graphID]->reaches(from, to, reachVar);
+		} else {
+			parseError(1, "Undeclared graph identifier %d", graphID);
+		}
+	}
+
 	bool parseLine(B& in, Solver& S) {
 		
 		skipWhitespace(in);
@@ -1119,14 +1157,18 @@ public:
 				graphs[i]->setBVTheory(bvTheory);
 		}
 
+		//(edges with undefined bitvectors are dropped, and reported once the other constraints have been implemented)
+		int undefined_bv = -1, undefined_edge = -1;
 		for (auto & e:bvedges){
 			if(!bvTheory->hasBV(e.bvID)){
-				printf("PARSE ERROR! Undefined bitvector %d for edge %d\n", e.bvID, e.edgeVar), exit(1);
+				if (undefined_edge < 0) {
+					undefined_bv = e.bvID;
+					undefined_edge = e.edgeVar;
+				}
+			}else{
+				graphs[e.graphID]->newEdgeBV(e.from, e.to, e.edgeVar, e.bvID);
 			}
 		}
-		for (auto & e:bvedges){
-			graphs[e.graphID]->newEdgeBV(e.from, e.to, e.edgeVar, e.bvID);
-		}
 
 		for (auto & e: distances_long){
 			graphs[e.graphID]->distance(e.from, e.to, e.var, e.weight,!e.strict);
@@ -1171,8 +1213,7 @@ public:
 			else if (graphs_rational[graphID])
 				graphs_rational[graphID]->setEdgePriority(graphs_rational[graphID]->getEdgeID(v),p.priority);
 			else {
-				printf("PARSE ERROR! Undeclared graph identifier %d\n", graphID), exit(1);
-				exit(1);
+				parseError(1, "Undeclared graph identifier %d", graphID);
 			}*/
 		}
 
@@ -1190,6 +1231,20 @@ public:
 		}
 		if (pbtheory)
 			pbtheory->implementConstraints();
+
+		//these have all been implemented now (this parser may be called again, for constraints added between solves)
+		bvedges.clear();
+		distances_long.clear();
+		distances_float.clear();
+		distances_rational.clear();
+		bvdistances.clear();
+		maxflows_long.clear();
+		maxflows_float.clear();
+		maxflows_rational.clear();
+		bvmaxflows.clear();
+		edgePriorities.clear();
+		if (undefined_edge >= 0)
+			parseError(1, "Undefined bitvector %d for edge %d", undefined_bv, undefined_edge);
 	}
 
 	
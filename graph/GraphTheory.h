@@ -746,6 +746,8 @@ public:
 	}
 
 	void setBVTheory(BVTheorySolver<Weight> * bv){
+		if (bv == comparator)
+			return;
 		comparator = bv;
 		if(bv){
 			bv->addTheory(this);
@@ -1014,6 +1016,19 @@ public:
 		for (int i = 0; i < n; i++)
 			newNode();
 	}
+	//Preallocate storage for n edges in total (such as the edge count declared in a gnf file).
+	void reserveEdges(int n) {
+		if (n <= 0)
+			return;
+		edge_list.capacity(n);
+		edge_weights.reserve(n);
+		vars.capacity(vars.size() + n);
+		g_under.reserveEdges(n);
+		g_over.reserveEdges(n);
+		g_under_weights_over.reserveEdges(n);
+		g_over_weights_under.reserveEdges(n);
+		cutGraph.reserveEdges(2 * n);
+	}
 	int nNodes() {
 		return g_under.nodes();
 	}
@@ -1321,6 +1336,7 @@ public:
 			assert(decisionLevel() == untilLevel);
 
 			for (Detector * d : detectors) {
+				MONOSAT_PROFILE_SCOPE(d->profileSite(getGraphID()), Backtrack);
 				d->backtrack(untilLevel);
 			}
 		}
@@ -1382,6 +1398,7 @@ public:
 		requiresPropagation = true;
 
 		for (Detector * d : detectors) {
+			MONOSAT_PROFILE_SCOPE(d->profileSite(getGraphID()), Backtrack);
 			d->backtrack(this->decisionLevel());
 		}
 
@@ -1424,6 +1441,14 @@ public:
 
 	}
 
+	void addPhaseHints(vec<Lit> & hints){
+		int start = hints.size();
+		for (Detector * d : detectors)
+			d->addPhaseHints(hints);
+		for (int i = start; i < hints.size(); i++)
+			hints[i] = toSolver(hints[i]);
+	}
+
 	Lit decideTheory() {
 		if (!opt_decide_theories)
 			return lit_Undef;
@@ -1459,7 +1484,11 @@ public:
 
 		for (int i = 0; i < detectors.size(); i++) {
 			Detector * r = detectors[i];
-			Lit l = r->decide();
+			Lit l;
+			{
+				MONOSAT_PROFILE_SCOPE(r->profileSite(getGraphID()), Decide);
+				l = r->decide();
+			}
 			if (l != lit_Undef) {
 
 				if(opt_decide_graph_bv && !sign(l) && isEdgeVar(var(l)) && hasBitVector(getEdgeID(var(l))) && r->supportsEdgeDecisions()){
@@ -1556,7 +1585,10 @@ public:
 			backtrackUntil(p);
 
 			assert(d < detectors.size());
-			detectors[d]->buildReason(p, reason, marker);
+			{
+				MONOSAT_PROFILE_SCOPE(detectors[d]->profileSite(getGraphID()), Reason);
+				detectors[d]->buildReason(p, reason, marker);
+			}
 			toSolver(reason);
 			double finish = rtime(1);
 			stats_reason_time += finish - start;
@@ -1754,7 +1786,7 @@ public:
 		Var v = var(l);
 
 		int lev = level(v);//level from the SAT solver.
-		if(!opt_lazy_backtrack){
+		if(!opt_lazy_backtrack && opt_chrono_backtrack<0){
 			assert(decisionLevel() <= lev);
 		}
 
@@ -2005,7 +2037,11 @@ public:
 			assert(conflict.size() == 0);
 			Lit l = lit_Undef;
 			bool backtrackOnly = lazy_backtracking_enabled && (opt_lazy_conflicts==3) &&  lazy_trail_head!=var_Undef;
-			bool r = detectors[d]->propagate(conflict,backtrackOnly,l);
+			bool r;
+			{
+				MONOSAT_PROFILE_SCOPE(detectors[d]->profileSite(getGraphID()), Propagate);
+				r = detectors[d]->propagate(conflict,backtrackOnly,l);
+			}
 			if(!r && backtrackOnly && conflict.size()==0){
 				backtrackUntil(decisionLevel());
 				stats_num_lazy_conflicts++;
@@ -2156,6 +2192,10 @@ public:
 	bool supportsLazyBacktracking(){
 		return lazy_backtracking_enabled;
 	}
+	//Literals assigned out of order are placed at the current level of the trail (see enqueueTheory()).
+	bool supportsChronologicalBacktracking(){
+		return true;
+	}
 
 	bool solveTheory(vec<Lit> & conflict) {
 		requiresPropagation = true;		//Just to be on the safe side... but this shouldn't really be required.
@@ -1627,6 +1627,35 @@ bool ReachDetector<Weight>::getModel_Path(int node, std::vector<int> & store_pat
 	return true;
  }
 
+//For each node that must be reachable but is not yet reachable in the under approximation,
+//suggest the unassigned edges of a path to it in the over approximation (as in decide()).
+//(The solver calls this after backtracking from a conflict, so both approximations are brought up to date with the trail first.)
+template<typename Weight>
+void ReachDetector<Weight>::addPhaseHints(vec<Lit> & hints) {
+	auto * over_path = overapprox_path_detector;
+	auto * under_reach = underapprox_detector;
+	if (!under_reach)
+		under_reach = underapprox_fast_detector;
+	if (!over_path || !under_reach)
+		return;
+	over_path->update();
+	under_reach->update();
+	for (int k = 0; k < reach_lits.size(); k++) {
+		Lit l = reach_lits[k];
+		if (l == lit_Undef || outer->value(l) != l_True)
+			continue;
+		int p = getNode(var(l));
+		if (!over_path->connected(p) || under_reach->connected(p))
+			continue;
+		while (p != source && !under_reach->connected(p)) {
+			Var edge_var = outer->getEdgeVar(over_path->incomingEdge(p));
+			if (outer->value(edge_var) == l_Undef)
+				hints.push(mkLit(edge_var, false));
+			p = over_path->previous(p);
+		}
+	}
+}
+
 template<typename Weight>
 bool ReachDetector<Weight>::getModel_PathByEdgeLit(int node, std::vector<Lit> & store_path){
 	store_path.clear();
@@ -278,6 +278,7 @@ public:
 
 	void addLit(int from, int to, Var reach_var);
 	Lit decide();
+	void addPhaseHints(vec<Lit> & hints);
 	void preprocess();
 	void dbg_sync_reachability();
 
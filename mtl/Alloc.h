@@ -67,6 +67,13 @@ public:
 	void free(int size) {
 		wasted_ += size;
 	}
+	// Discard everything from 'new_size' up, of which 'reclaimed' words had already been freed:
+	void truncate(uint32_t new_size, uint32_t reclaimed) {
+		assert(new_size <= sz);
+		assert(reclaimed <= wasted_);
+		sz = new_size;
+		wasted_ -= reclaimed;
+	}
 	
 	// Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
 	T& operator[](Ref r) {
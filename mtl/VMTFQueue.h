@@ -0,0 +1,163 @@
+/*************************************************************************************[VMTFQueue.h]
+ The MIT License (MIT)
+
+ Copyright (c) 2014, Sam Bayless
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+ associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute,
+ sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all copies or
+ substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+ NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+ NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ **************************************************************************************************/
+
+#ifndef VMTFQUEUE_H_
+#define VMTFQUEUE_H_
+
+#include <cstdint>
+#include <utility>
+#include "mtl/Vec.h"
+
+namespace Monosat {
+
+//=================================================================================================
+// Variable-move-to-front queue, with one queue (bucket) per priority.
+//
+// Each bucket is a doubly linked list of elements, ordered by the time they were last moved to the front
+// (their 'stamp'). Each bucket also has a search cursor, with the invariant that every element in front of
+// the cursor is 'skipped' (assigned, for a SAT solver); so finding the next element only walks back from the cursor,
+// and it is the caller's responsibility to call 'update()' for every element that stops being skipped.
+// Buckets are searched in order of decreasing priority.
+
+class VMTFQueue {
+	struct Link {
+		int prev = -1;
+		int next = -1;
+		uint64_t stamp = 0;
+	};
+	struct Bucket {
+		unsigned priority;
+		int first = -1;   //least recently moved to front
+		int last = -1;    //most recently moved to front
+		int search = -1;  //elements after this one are all skipped
+		Bucket(unsigned priority) :
+				priority(priority) {
+		}
+	};
+
+	vec<Link> links;
+	vec<int> bucket_of;
+	vec<Bucket> buckets;
+	vec<int> bucket_order; //bucket indices, in order of decreasing priority
+	uint64_t stamp_counter = 0;
+
+	int getBucket(unsigned priority) {
+		for (int b : bucket_order) {
+			if (buckets[b].priority == priority)
+				return b;
+		}
+		int b = buckets.size();
+		buckets.push(Bucket(priority));
+		bucket_order.push(b);
+		for (int i = bucket_order.size() - 1; i > 0 && buckets[bucket_order[i - 1]].priority < priority; i--)
+			std::swap(bucket_order[i], bucket_order[i - 1]);
+		return b;
+	}
+
+	void dequeue(int n) {
+		Bucket & b = buckets[bucket_of[n]];
+		Link & l = links[n];
+		if (b.search == n)
+			b.search = l.prev >= 0 ? l.prev : l.next;
+		if (l.prev >= 0)
+			links[l.prev].next = l.next;
+		else
+			b.first = l.next;
+		if (l.next >= 0)
+			links[l.next].prev = l.prev;
+		else
+			b.last = l.prev;
+		l.prev = l.next = -1;
+	}
+
+	void enqueue(int n, int bucket) {
+		Bucket & b = buckets[bucket];
+		bucket_of[n] = bucket;
+		Link & l = links[n];
+		l.prev = b.last;
+		l.next = -1;
+		l.stamp = ++stamp_counter;
+		if (b.last >= 0)
+			links[b.last].next = n;
+		else
+			b.first = n;
+		b.last = n;
+	}
+
+public:
+	int size() const {
+		return links.size();
+	}
+	uint64_t stamp(int n) const {
+		return links[n].stamp;
+	}
+
+	//Add a new element 'n' (elements must be added in order, starting from 0) to the front of the queue for 'priority'.
+	void insert(int n, unsigned priority) {
+		assert(n == links.size());
+		links.push();
+		bucket_of.push(-1);
+		enqueue(n, getBucket(priority));
+	}
+
+	void setPriority(int n, unsigned priority) {
+		int to = getBucket(priority);
+		if (to == bucket_of[n])
+			return;
+		dequeue(n);
+		enqueue(n, to);
+	}
+
+	//Move 'n' to the front of its queue.
+	void moveToFront(int n) {
+		if (buckets[bucket_of[n]].last == n)
+			return;
+		int b = bucket_of[n];
+		dequeue(n);
+		enqueue(n, b);
+	}
+
+	//Call when 'n' is no longer skipped by next() (for a SAT solver, when it becomes unassigned).
+	void update(int n) {
+		Bucket & b = buckets[bucket_of[n]];
+		if (b.search < 0 || links[b.search].stamp < links[n].stamp)
+			b.search = n;
+	}
+
+	//Returns the most recently moved element, of the highest priority, for which 'skip' is false (or -1 if there is none).
+	template<class Skip>
+	int next(Skip && skip) {
+		for (int bi : bucket_order) {
+			Bucket & b = buckets[bi];
+			int n = b.search;
+			while (n >= 0 && skip(n))
+				n = links[n].prev;
+			b.search = n;
+			if (n >= 0)
+				return n;
+		}
+		return -1;
+	}
+};
+
+}
+
+#endif /* VMTFQUEUE_H_ */
@@ -253,12 +253,15 @@ public:
 	inline int decisionLevel() {
 		return S->decisionLevel();
 	}
+	bool supportsChronologicalBacktracking() {
+		return true;
+	}
 	void enqueueTheory(Lit l) {
 		Var v = var(l);
 		
 		int lev = level(v);
 		
-		assert(decisionLevel() <= lev);
+		assert(decisionLevel() <= lev || opt_chrono_backtrack >= 0);
 		if (value(l) != l_Undef)
 			return;
 		while (lev > trail_lim.size()) {
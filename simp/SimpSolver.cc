@@ -24,6 +24,8 @@
 #include "mtl/Sort.h"
 #include "simp/SimpSolver.h"
 #include "utils/System.h"
+#include <thread>
+#include <vector>
 
 using namespace Monosat;
 
@@ -45,13 +47,16 @@ static IntOption opt_subsumption_lim(_cat, "sub-lim",
 static DoubleOption opt_simp_garbage_frac(_cat, "simp-gc-frac",
 		"The fraction of wasted memory allowed before a garbage collection is triggered during simplification.", 0.5,
 		DoubleRange(0, false, HUGE_VAL, false));
+static IntOption opt_simp_threads(_cat, "simp-threads",
+		"Number of threads used to find subsumed clauses and eliminable variables. The result is the same for any number of threads > 1.",
+		1, IntRange(1, 1024));
 
 //=================================================================================================
 // Constructor/Destructor:
 
 SimpSolver::SimpSolver() :
 		grow(opt_grow), clause_lim(opt_clause_lim), subsumption_lim(opt_subsumption_lim), simp_garbage_frac(
-				opt_simp_garbage_frac), use_asymm(opt_use_asymm), use_rcheck(opt_use_rcheck), use_elim(opt_use_elim), merges(
+				opt_simp_garbage_frac), use_asymm(opt_use_asymm), use_rcheck(opt_use_rcheck), use_elim(opt_use_elim), simp_threads(opt_simp_threads), merges(
 				0), asymm_lits(0), eliminated_vars(0), elimorder(1), use_simplification(true), occurs(
 				ClauseDeleted(ca)), elim_heap(ElimLt(n_occ)), bwdsub_assigns(0), n_touched(0) {
 	vec<Lit> dummy(1, lit_Undef);
@@ -74,6 +79,7 @@ Var SimpSolver::newVar(bool sign, bool dvar) {
 		n_occ.push(0);
 		occurs.init(v);
 		touched.push(0);
+		occ_stamp.push(0);
 		elim_heap.insert(v);
 	}
 	return v;
@@ -86,6 +92,7 @@ lbool SimpSolver::solve_(bool do_simp, bool turn_off_simp) {
 	do_simp &= use_simplification;
 	
 	if (do_simp) {
+		cancelUntil(0); //variable elimination can't keep any of the previous trail
 		// Assumptions must be temporarily frozen to run variable elimination:
 		for (int i = 0; i < assumptions.size(); i++) {
 			Var v = var(assumptions[i]);
@@ -125,6 +132,8 @@ bool SimpSolver::addClause_(vec<Lit>& ps) {
 		assert(!isEliminated(var(ps[i])));
 #endif
 	
+	if (decisionLevel() > 0)
+		cancelUntil(0); //(see Solver::addClause_())
 	int nclauses = clauses.size();
 	
 	if (use_rcheck && implied(ps))
@@ -148,6 +157,7 @@ bool SimpSolver::addClause_(vec<Lit>& ps) {
 			occurs[var(c[i])].push(cr);
 			n_occ[toInt(c[i])]++;
 			touched[var(c[i])] = 1;
+			occ_stamp[var(c[i])]++;
 			n_touched++;
 			if (elim_heap.inHeap(var(c[i])))
 				elim_heap.increase(var(c[i]));
@@ -162,6 +172,7 @@ void SimpSolver::removeClause(CRef cr) {
 	if (use_simplification)
 		for (int i = 0; i < c.size(); i++) {
 			n_occ[toInt(c[i])]--;
+			occ_stamp[var(c[i])]++;
 			updateElimHeap(var(c[i]));
 			occurs.smudge(var(c[i]));
 		}
@@ -178,7 +189,20 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l) {
 	// FIX: this is too inefficient but would be nice to have (properly implemented)
 	// if (!find(subsumption_queue, &c))
 	subsumption_queue.insert(cr);
+	for (Lit lit : c)
+		occ_stamp[var(lit)]++;
 	
+	if (proof) {
+		//The strengthened clause must be in the proof before the original is deleted (either below, or by 'removeClause()').
+		proof_clause.clear();
+		proof_original.clear();
+		for (int i = 0; i < c.size(); i++) {
+			proof_original.push(c[i]);
+			if (c[i] != l && value(c[i]) != l_False)
+				proof_clause.push(c[i]);
+		}
+		proof->add(proof_clause);
+	}
 	if (c.size() == 2) {
 		removeClause(cr);
 		c.strengthen(l);
@@ -213,6 +237,8 @@ bool SimpSolver::strengthenClause(CRef cr, Lit l) {
 			removeClause(cr);
 			c.strengthen(l);
 		} else {
+			if (proof)
+				proof->remove(proof_original);
 			c.strengthen(l);
 			attachClause(cr);
 			remove(occurs[var(l)], cr);
@@ -257,8 +283,6 @@ bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& ou
 
 // Returns FALSE if clause is always satisfied.
 bool SimpSolver::merge(const Clause& _ps, const Clause& _qs, Var v, int& size) {
-	merges++;
-	
 	bool ps_smallest = _ps.size() < _qs.size();
 	const Clause& ps = ps_smallest ? _qs : _ps;
 	const Clause& qs = ps_smallest ? _ps : _qs;
@@ -401,6 +425,85 @@ bool SimpSolver::backwardSubsumptionCheck(bool verbose) {
 	return true;
 }
 
+//Call f(i) for each i in [0, n), with the indices divided among 'threads' threads in a fixed pattern.
+template<class F>
+static void parallelFor(int threads, int n, const F & f) {
+	if (threads <= 1 || n < 2) {
+		for (int i = 0; i < n; i++)
+			f(i);
+		return;
+	}
+	std::vector<std::thread> workers;
+	for (int t = 0; t < threads; t++) {
+		workers.emplace_back([&f, t, threads, n]() {
+			for (int i = t; i < n; i += threads)
+				f(i);
+		});
+	}
+	for (std::thread & w : workers)
+		w.join();
+}
+
+//Collect the clauses that 'cr' subsumes or strengthens. This only reads the clause database (and the occurrence lists
+//must be clean), so it can be called from several threads at once.
+void SimpSolver::findSubsumed(CRef cr, vec<CRef>& out) const {
+	const Clause& c = ca[cr];
+	out.clear();
+	if (c.mark())
+		return;
+	Var best = var(c[0]);
+	for (int i = 1; i < c.size(); i++)
+		if (occurs[var(c[i])].size() < occurs[best].size())
+			best = var(c[i]);
+	const vec<CRef>& cs = occurs[best];
+	for (int j = 0; j < cs.size(); j++) {
+		const Clause& d = ca[cs[j]];
+		if (!d.mark() && cs[j] != cr && (subsumption_lim == -1 || d.size() < subsumption_lim)
+				&& c.subsumes(d) != lit_Error)
+			out.push(cs[j]);
+	}
+}
+
+// Backward subsumption + backward subsumption resolution, for large subsumption queues:
+// The subsumed and strengthened clauses of a batch of queued clauses are found in parallel, and then removed and strengthened
+// in the order of the queue (checking each subsumption again, as earlier ones may have changed the clauses).
+// The clauses that it strengthens (and the top-level assignments) are left for 'backwardSubsumptionCheck()'.
+bool SimpSolver::parallelSubsumptionCheck() {
+	static const int BatchSize = 1 << 16;
+	static const int MinQueue = 1024;
+	vec<CRef> batch;
+	vec<vec<CRef>> found;
+	while (subsumption_queue.size() >= MinQueue && !asynch_interrupt) {
+		occurs.cleanAll();
+		batch.clear();
+		while (subsumption_queue.size() > 0 && batch.size() < BatchSize) {
+			CRef cr = subsumption_queue.peek();
+			subsumption_queue.pop();
+			if (!ca[cr].mark())
+				batch.push(cr);
+		}
+		found.growTo(batch.size());
+		parallelFor(simp_threads, batch.size(), [&](int i) {
+			findSubsumed(batch[i], found[i]);
+		});
+		for (int i = 0; i < batch.size(); i++) {
+			Clause& c = ca[batch[i]];
+			for (CRef d : found[i]) {
+				if (c.mark())
+					break;
+				if (ca[d].mark())
+					continue;
+				Lit l = c.subsumes(ca[d]);
+				if (l == lit_Undef)
+					removeClause(d);
+				else if (l != lit_Error && !strengthenClause(d, ~l))
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
 bool SimpSolver::asymm(Var v, CRef cr) {
 	Clause& c = ca[cr];
 	assert(decisionLevel() == 0);
@@ -470,28 +573,46 @@ static void mkElimClause(vec<uint32_t>& elimclauses, Var v, Clause& c) {
 	elimclauses.push(c.size());
 }
 
-bool SimpSolver::eliminateVar(Var v) {
-	assert(!frozen[v]);
-	assert(!isEliminated(v));
-	assert(value(v) == l_Undef);
-	// Split the occurrences into positive and negative:
-	//
-	const vec<CRef>& cls = occurs.lookup(v);
+// Check wether the increase in number of clauses from eliminating 'v' stays within the allowed ('grow'). Moreover, no
+// clause must exceed the limit on the maximal clause size (if it is set).
+// This only reads the clause database (and occurs[v] must be clean), so it can be called from several threads at once.
+bool SimpSolver::eliminationBounded(Var v, uint64_t& n_merges) const {
+	const vec<CRef>& cls = occurs[v];
 	vec<CRef> pos, neg;
 	for (int i = 0; i < cls.size(); i++)
 		(find(ca[cls[i]], mkLit(v)) ? pos : neg).push(cls[i]);
 	
-	// Check wether the increase in number of clauses stays within the allowed ('grow'). Moreover, no
-	// clause must exceed the limit on the maximal clause size (if it is set):
-	//
 	int cnt = 0;
 	int clause_size = 0;
 	
 	for (int i = 0; i < pos.size(); i++)
-		for (int j = 0; j < neg.size(); j++)
+		for (int j = 0; j < neg.size(); j++) {
+			n_merges++;
 			if (merge(ca[pos[i]], ca[neg[j]], v, clause_size)
 					&& (++cnt > cls.size() + grow || (clause_lim != -1 && clause_size > clause_lim)))
-				return true;
+				return false;
+		}
+	return true;
+}
+
+bool SimpSolver::eliminateVar(Var v, bool check_bounds) {
+	assert(!frozen[v]);
+	assert(!isEliminated(v));
+	assert(value(v) == l_Undef);
+	const vec<CRef>& cls = occurs.lookup(v);
+	if (check_bounds) {
+		uint64_t n_merges = 0;
+		bool bounded = eliminationBounded(v, n_merges);
+		merges += n_merges;
+		if (!bounded)
+			return true;
+	}
+	
+	// Split the occurrences into positive and negative:
+	//
+	vec<CRef> pos, neg;
+	for (int i = 0; i < cls.size(); i++)
+		(find(ca[cls[i]], mkLit(v)) ? pos : neg).push(cls[i]);
 	
 	// Delete and store old clauses:
 	eliminated[v] = true;
@@ -508,15 +629,28 @@ bool SimpSolver::eliminateVar(Var v) {
 		mkElimClause(elimclauses, ~mkLit(v));
 	}
 	
+	vec<Lit>& resolvent = add_tmp;
+	if (proof) {
+		//The proof must derive the resolvents before the clauses they are resolved from are deleted.
+		for (int i = 0; i < pos.size(); i++)
+			for (int j = 0; j < neg.size(); j++)
+				if (merge(ca[pos[i]], ca[neg[j]], v, resolvent))
+					proof->add(resolvent);
+	}
 	for (int i = 0; i < cls.size(); i++)
 		removeClause(cls[i]);
 	
 	// Produce clauses in cross product:
-	vec<Lit>& resolvent = add_tmp;
-	for (int i = 0; i < pos.size(); i++)
-		for (int j = 0; j < neg.size(); j++)
+	int prev_source = proof_source;
+	proof_source = ProofLogged;
+	bool consistent = true;
+	for (int i = 0; i < pos.size() && consistent; i++)
+		for (int j = 0; j < neg.size() && consistent; j++)
 			if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addClause_(resolvent))
-				return false;
+				consistent = false;
+	proof_source = prev_source;
+	if (!consistent)
+		return false;
 	
 	// Free occurs list for this variable:
 	occurs[v].clear(true);
@@ -526,10 +660,61 @@ bool SimpSolver::eliminateVar(Var v) {
 		watches[mkLit(v)].clear(true);
 	if (watches[~mkLit(v)].size() == 0)
 		watches[~mkLit(v)].clear(true);
+	if (watches_bin[mkLit(v)].size() == 0)
+		watches_bin[mkLit(v)].clear(true);
+	if (watches_bin[~mkLit(v)].size() == 0)
+		watches_bin[~mkLit(v)].clear(true);
 	
 	return backwardSubsumptionCheck();
 }
 
+// Variable elimination with several threads:
+// Batches of candidates are taken from the elimination heap (in order), and whether each can be eliminated within the
+// bounds is checked in parallel. Then they are eliminated, in order; as earlier eliminations can change the clauses of
+// later candidates, a candidate whose clauses were touched since it was checked (see 'occ_stamp') is checked again.
+// The batches do not depend on the number of threads, so neither does the result.
+bool SimpSolver::eliminateParallel() {
+	static const int BatchSize = 4096;
+	vec<Var> batch;
+	vec<uint32_t> stamps;
+	vec<char> bounded;
+	std::vector<uint64_t> n_merges;
+	while (!elim_heap.empty() && !asynch_interrupt) {
+		occurs.cleanAll();
+		batch.clear();
+		stamps.clear();
+		while (!elim_heap.empty() && batch.size() < BatchSize) {
+			Var v = elim_heap.removeMin();
+			if (isEliminated(v) || value(v) != l_Undef || frozen[v])
+				continue;
+			batch.push(v);
+			stamps.push(occ_stamp[v]);
+		}
+
+		bounded.clear();
+		bounded.growTo(batch.size(), 0);
+		n_merges.assign(batch.size(), 0);
+		parallelFor(simp_threads, batch.size(), [&](int i) {
+			bounded[i] = eliminationBounded(batch[i], n_merges[i]);
+		});
+		for (uint64_t n : n_merges)
+			merges += n;
+
+		for (int i = 0; i < batch.size() && !asynch_interrupt; i++) {
+			Var v = batch[i];
+			if (isEliminated(v) || value(v) != l_Undef)
+				continue;
+			bool touched_since = occ_stamp[v] != stamps[i];
+			if (!touched_since && !bounded[i])
+				continue;
+			if (!eliminateVar(v, touched_since))
+				return false;
+			checkGarbage(simp_garbage_frac);
+		}
+	}
+	return true;
+}
+
 bool SimpSolver::substitute(Var v, Lit x) {
 	assert(!frozen[v]);
 	assert(!isEliminated(v));
@@ -588,6 +773,10 @@ bool SimpSolver::eliminate(bool turn_off_elim) {
 		
 		gatherTouchedClauses();
 		// printf("  ## (time = %6.2f s) BWD-SUB: queue = %d, trail = %d\n", cpuTime(), subsumption_queue.size(), trail.size() - bwdsub_assigns);
+		if (simp_threads > 1 && !parallelSubsumptionCheck()) {
+			ok = false;
+			goto cleanup;
+		}
 		if ((subsumption_queue.size() > 0 || bwdsub_assigns < trail.size()) && !backwardSubsumptionCheck(true)) {
 			ok = false;
 			goto cleanup;
@@ -603,6 +792,10 @@ bool SimpSolver::eliminate(bool turn_off_elim) {
 		}
 		
 		// printf("  ## (time = %6.2f s) ELIM: vars = %d\n", cpuTime(), elim_heap.size());
+		if (simp_threads > 1 && use_elim && !use_asymm && !eliminateParallel()) {
+			ok = false;
+			goto cleanup;
+		}
 		for (int cnt = 0; !elim_heap.empty(); cnt++) {
 			Var elim = elim_heap.removeMin();
 			
@@ -643,6 +836,7 @@ bool SimpSolver::eliminate(bool turn_off_elim) {
 	// If no more simplification is needed, free all simplification-related data structures:
 	if (turn_off_elim) {
 		touched.clear(true);
+		occ_stamp.clear(true);
 		occurs.clear(true);
 		n_occ.clear(true);
 		elim_heap.clear(true);
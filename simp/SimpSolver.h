@@ -101,6 +101,7 @@ public:
 	bool use_asymm;         // Shrink clauses by asymmetric branching.
 	bool use_rcheck;        // Check if a clause is already implied. Prett costly, and subsumes subsumptions :)
 	bool use_elim;          // Perform variable elimination.
+	int simp_threads;       // Threads used to find subsumed clauses and eliminable variables (1 means sequential).
 	
 	// Statistics:
 	//
@@ -158,6 +159,9 @@ protected:
 	vec<char> eliminated;
 	int bwdsub_assigns;
 	int n_touched;
+	vec<Lit> proof_clause;   // Strengthened clause, for the proof (see 'strengthenClause()').
+	vec<Lit> proof_original; // The clause before it was strengthened.
+	vec<uint32_t> occ_stamp; // Incremented whenever a clause containing the variable is added, removed or changed (see 'eliminateParallel()').
 
 	// Temporaries:
 	//
@@ -171,9 +175,13 @@ protected:
 	void updateElimHeap(Var v);
 	void gatherTouchedClauses();
 	bool merge(const Clause& _ps, const Clause& _qs, Var v, vec<Lit>& out_clause);
-	bool merge(const Clause& _ps, const Clause& _qs, Var v, int& size);
+	static bool merge(const Clause& _ps, const Clause& _qs, Var v, int& size);
 	bool backwardSubsumptionCheck(bool verbose = false);
-	bool eliminateVar(Var v);
+	bool parallelSubsumptionCheck();
+	void findSubsumed(CRef cr, vec<CRef>& out) const;
+	bool eliminateVar(Var v, bool check_bounds = true);
+	bool eliminateParallel();
+	bool eliminationBounded(Var v, uint64_t& n_merges) const;
 	void extendModel();
 
 	void removeClause(CRef cr);
@@ -181,6 +189,9 @@ protected:
 	void cleanUpClauses();
 	bool implied(const vec<Lit>& c);
 	void relocAll(ClauseAllocator& to);
+	bool canCollectYoung() {
+		return !use_simplification; //the occurrence lists also refer to clauses
+	}
 };
 
 //=================================================================================================
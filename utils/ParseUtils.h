@@ -21,13 +21,42 @@
 #ifndef Minisat_ParseUtils_h
 #define Minisat_ParseUtils_h
 
+#include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdarg.h>
 
 #include <zlib.h>
+#include <string>
+#include <vector>
 #include "mtl/Vec.h"
 namespace Monosat {
 
+//-------------------------------------------------------------------------------------------------
+// Malformed input:
+
+//The parsers throw this (rather than exiting) on malformed input, so that input that is added between solves (see
+//-stream and -server) can be rejected, while the solver keeps running. 'status' is the exit status of the program,
+//for input that it cannot recover from (see Main.cc).
+class ParseError {
+public:
+	std::string message;
+	int status;
+	ParseError(const std::string & message, int status) :
+			message(message), status(status) {
+	}
+};
+
+//Throw a ParseError, with a printf-style message.
+[[noreturn]] static inline void parseError(int status, const char * fmt, ...) {
+	char buf[1024];
+	va_list args;
+	va_start(args, fmt);
+	vsnprintf(buf, sizeof(buf), fmt, args);
+	va_end(args);
+	throw ParseError(buf, status);
+}
+
 //-------------------------------------------------------------------------------------------------
 // A simple buffered character stream class:
 
@@ -112,13 +141,14 @@ static int parseInt(B& in) {
 	else if (*in == '+')
 		++in;
 	if (*in < '0' || *in > '9')
-		fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
+		parseError(3, "Unexpected char: %c", *in);
 	while (*in >= '0' && *in <= '9')
 		val = val * 10 + (*in - '0'), ++in;
 	return neg ? -val : val;
 }
+//Parse a long, checking for overflow (used for weights and constants, which are 64 bit).
 template<class B>
-static int parseLong(B& in) {
+static long parseLong(B& in) {
 	long val = 0;
 	bool neg = false;
 	skipWhitespace(in);
@@ -127,9 +157,13 @@ static int parseLong(B& in) {
 	else if (*in == '+')
 		++in;
 	if (*in < '0' || *in > '9')
-		fprintf(stderr, "PARSE ERROR! Unexpected char: %c\n", *in), exit(3);
-	while (*in >= '0' && *in <= '9')
-		val = val * 10 + (*in - '0'), ++in;
+		parseError(3, "Unexpected char: %c", *in);
+	while (*in >= '0' && *in <= '9') {
+		int digit = *in - '0';
+		if (val > (LONG_MAX - digit) / 10)
+			parseError(3, "Integer out of range");
+		val = val * 10 + digit, ++in;
+	}
 	return neg ? -val : val;
 }
 
@@ -148,6 +182,41 @@ static double parseDouble(B& in, vec<char> & tmp) {
 	return strtod(&tmp[0], nullptr);
 }
 
+// Bounded parsing of (memory mapped) text: read an integer from [p, eol), skipping leading whitespace, and advance p past it.
+// Returns false (leaving p unspecified) if there is no integer there, or if it does not fit in an int.
+static inline bool parseIntBounded(const char *& p, const char * eol, int & val) {
+	while (p < eol && isWhitespace(*p))
+		p++;
+	bool neg = false;
+	if (p < eol && *p == '-')
+		neg = true, p++;
+	else if (p < eol && *p == '+')
+		p++;
+	if (p >= eol || *p < '0' || *p > '9')
+		return false;
+	long v = 0;
+	while (p < eol && *p >= '0' && *p <= '9') {
+		v = v * 10 + (*p++ - '0');
+		if (v > 2147483647L)
+			return false;
+	}
+	val = neg ? -v : v;
+	return true;
+}
+
+// Read the literals of a clause line [p, eol) into 'lits', followed by its terminating 0. Returns false if the line is
+// not a well formed clause (in which case it should be left to the ordinary parsing, which reports any errors).
+static inline bool tokenizeClause(const char * p, const char * eol, std::vector<int> & lits) {
+	for (;;) {
+		int val;
+		if (!parseIntBounded(p, eol, val))
+			return false; //(clauses are terminated by 0 on the same line)
+		lits.push_back(val);
+		if (val == 0)
+			return true;
+	}
+}
+
 // String matching: in case of a match the input iterator will be advanced the corresponding
 // number of characters.
 template<class B>